@@ -39,6 +39,25 @@
 // This should be enough ¯\_(ツ)_/¯
 #define APP_ROOM_CTX_STACK_SIZE 1024
 
+// Word entry strategy (see the Makefile)
+#ifndef APP_ENTERWORD_WEIGHTED_LAYOUT
+#define APP_ENTERWORD_WEIGHTED_LAYOUT 1
+#endif
+#ifndef APP_ENTERWORD_PICK_MAX
+#define APP_ENTERWORD_PICK_MAX 2
+#endif
+#ifndef APP_ENTERSEED_AUTO_ADVANCE
+#define APP_ENTERSEED_AUTO_ADVANCE 1
+#endif
+#ifndef APP_ENTERSEED_SCROLL_ACCEL
+#define APP_ENTERSEED_SCROLL_ACCEL 1
+#endif
+
+// Debugging features (see the Makefile)
+#ifndef APP_DEBUG
+#define APP_DEBUG 0
+#endif
+
 #define APP_STR(x) APP_STR_(x)
 #define APP_STR_(x) #x
 
@@ -65,4 +84,13 @@ void app_init();
 void app_io_event();
 void app_disp_invalidate();
 
+#if APP_DEBUG
+/*
+ * Get the greatest number of bytes of the room stack that have been in use at once since the app started, rounded up to
+ * a multiple of 4. This is a lower bound: the stack is painted with a 32-bit pattern at startup, so if the highest word
+ * ever used happens to be left holding that exact pattern, the usage below it is all that is reported.
+ */
+uint16_t app_room_ctx_stack_peak();
+#endif
+
 #endif
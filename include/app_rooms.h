@@ -36,6 +36,11 @@
 //                                                                            //
 //----------------------------------------------------------------------------//
 
+typedef struct __attribute__((aligned(4))) {
+	// true to compare two backups with each other, false to compare a backup with the seed on the device
+	bool compare_backups;
+} app_room_verifybackup_args_t;
+
 typedef struct {
 	// The number of words in the seed; 12, 18, or 24
 	uint8_t seed_length;
@@ -44,14 +49,54 @@ typedef struct {
 typedef struct __attribute__((aligned(4))) {
 	// The number of words in the seed; 12, 18, or 24
 	uint8_t seed_length;
+	// The indices of the words to fill in initially (seed_length of them), or NULL to start with no words entered
+	const uint16_t *indices;
 } app_room_enterseed_args_t;
 
+typedef uint8_t app_room_enterword_mode_t;
+#define APP_ROOM_ENTERWORD_MODE_LETTERS ((app_room_enterword_mode_t) 0) // The word is typed in letter by letter
+#define APP_ROOM_ENTERWORD_MODE_NUMBER  ((app_room_enterword_mode_t) 1) // The word's number in [1, 2048] is typed in
+#define APP_ROOM_ENTERWORD_MODE_BITS    ((app_room_enterword_mode_t) 2) // The word's 11 bit index is typed in
+#define APP_ROOM_ENTERWORD_MODE_FREE    ((app_room_enterword_mode_t) 3) // The word is typed in with any letters
+#define APP_ROOM_ENTERWORD_MODE_COUNT 4
+
 typedef struct __attribute__((aligned(4))) {
 	// The buffer in which to store the word (null-terminator included). Must have a capacity of at least
 	// APP_SEEDUTILS_WORD_LEN_MAX + 1 bytes.
 	char *word_buff;
+	// The way in which the word is typed in
+	app_room_enterword_mode_t mode;
 } app_room_enterword_args_t;
 
+typedef struct __attribute__((aligned(4))) {
+	// The index of the first word in the BIP 39 English wordlist to choose from; ignored if words is not NULL
+	uint16_t first;
+	// The number of words to choose from
+	uint8_t count;
+	// The indices of the words to choose from, offered as suggestions for a misspelled word, or NULL to choose from
+	// consecutive words starting at first
+	const uint16_t *words;
+} app_room_pickword_args_t;
+
+typedef struct {
+	// The index of the chosen word, or APP_SEEDUTILS_WORD_COUNT if no word was chosen
+	uint16_t word_index;
+} app_room_pickword_ret_t;
+
+typedef struct __attribute__((aligned(4))) {
+	// The index in the BIP 39 English wordlist of every word of the seed; the index at slot is ignored
+	uint16_t indices[24];
+	// The number of words in the seed; 12, 18, or 24
+	uint8_t word_count;
+	// The position in the seed of the word to recover
+	uint8_t slot;
+} app_room_recoverword_args_t;
+
+typedef struct {
+	// The index of the chosen word, or APP_SEEDUTILS_WORD_COUNT if no word was chosen
+	uint16_t word_index;
+} app_room_recoverword_ret_t;
+
 typedef uint8_t app_room_compareseed_ret_t;
 #define APP_ROOM_COMPARESEED_RET_EQUAL    ((app_room_compareseed_ret_t) 0)
 #define APP_ROOM_COMPARESEED_RET_UNEQUAL  ((app_room_compareseed_ret_t) 1)
@@ -69,8 +114,22 @@ extern const bui_room_t app_rooms_verifybackup;
 extern const bui_room_t app_rooms_chooselength;
 extern const bui_room_t app_rooms_enterseed;
 extern const bui_room_t app_rooms_enterword;
+extern const bui_room_t app_rooms_pickword;
+extern const bui_room_t app_rooms_recoverword;
 extern const bui_room_t app_rooms_compareseed;
+extern const bui_room_t app_rooms_fingerprint;
 
 extern const bui_room_t app_rooms_about;
 
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Determine if app_rooms_main is the current room, i.e. the user isn't in the middle of anything.
+ */
+bool app_room_main_current();
+
 #endif
@@ -28,6 +28,11 @@
 #define APP_SEEDUTILS_WORD_LEN_MIN 3
 #define APP_SEEDUTILS_WORD_LEN_MAX 8
 #define APP_SEEDUTILS_WORD_COUNT 2048
+#define APP_SEEDUTILS_SEED_LENGTH_MAX 24
+// The size of the packed entropy and checksum of a mnemonic of up to APP_SEEDUTILS_SEED_LENGTH_MAX words
+#define APP_SEEDUTILS_ENT_SIZE 33
+// The hardened BIP 32 child index 6516080' of the node compared by app_seedutils_compare()
+#define APP_SEEDUTILS_COMPARE_PATH 0x80636D70
 
 /*
  * Find all possible letters that may follow the beginning of the specified word in the BIP 39 English wordlist. All
@@ -38,14 +43,47 @@
  *     word_len: the length of word
  *     letters_dest: the destination in which to store all letters that may be used to continue the word (no
  *                   null-terminator); this must be big enough to store 26 letters
+ *     counts_dest: if not NULL, the number of BIP 39 words that continue word with each letter stored in letters_dest
+ *                  is stored here at the same position as the letter; this must be big enough to store 26 counts
  *     complete: if not NULL, this will be set to true if word is a complete BIP 39 word, or false otherwise
  *     prediction: if word is the prefix of exactly one BIP 39 word (or is an entire BIP 39 word), then this will be set
  *                 to the index of that word, otherwise this is set to -1; if this is NULL, it is not accessed
  * Returns:
  *     the number of letters stored in letters_dest; in [0, 26]
  */
-uint8_t app_seedutils_bip39_next_letters(const char *word, uint8_t word_len, char *letters_dest, bool *complete,
-		int16_t *prediction);
+uint8_t app_seedutils_bip39_next_letters(const char *word, uint8_t word_len, char *letters_dest, uint16_t *counts_dest,
+		bool *complete, int16_t *prediction);
+
+/*
+ * Reorder letters so that the letters leading to the most words are placed where they take fewer button presses to
+ * choose on a binary keyboard (bui_bkb). The binary keyboard repeatedly splits its letters into a left half and a right
+ * half by letter count, so the shape of the choice tree is fixed by letters_size and only the positions of the letters
+ * within it may be chosen. This assumes that the left half gets the extra letter when there is an odd number of them,
+ * which has not been checked against bui_bkb itself (the bui submodule is not part of this tree); if bui_bkb splits the
+ * other way, the result is still a valid ordering but not necessarily the best one. Under that assumption, assigning
+ * the heaviest letters to the shallowest positions gives the fewest expected presses for the tree shape. Letters of
+ * equal weight keep their order.
+ *
+ * Args:
+ *     letters: the letters to reorder, such as those found by app_seedutils_bip39_next_letters()
+ *     counts: the number of words that continue with each letter in letters
+ *     letters_size: the number of letters in letters; in [0, 26]
+ */
+void app_seedutils_order_letters(char *letters, const uint16_t *counts, uint8_t letters_size);
+
+/*
+ * Find the range of words in the BIP 39 English wordlist that begin with the specified prefix. Since the wordlist is in
+ * alphabetical order, these words are always contiguous. All letters provided to this function must be lower case ASCII
+ * letters.
+ *
+ * Args:
+ *     word: the start of a word
+ *     word_len: the length of word
+ *     first_dest: if not NULL and at least one word begins with word, the index of the first such word is stored here
+ * Returns:
+ *     the number of words in the wordlist that begin with word; in [0, 2048]
+ */
+uint16_t app_seedutils_bip39_prefix_range(const char *word, uint8_t word_len, uint16_t *first_dest);
 
 /*
  * Get the word at the specified index in the BIP 39 English wordlist.
@@ -69,6 +107,70 @@ const char* app_seedutils_bip39_word(uint16_t index, uint8_t *word_len_dest);
  */
 uint16_t app_seedutils_bip39_index(const char *word, uint8_t word_len);
 
+/*
+ * Find the words in the BIP 39 English wordlist that are a single edit away from the provided word: one letter inserted,
+ * deleted, or replaced, or two adjacent letters swapped. Words beginning with the same letter as word are ranked first,
+ * followed by words of the same length as word; words of equal rank are in wordlist order.
+ *
+ * Args:
+ *     word: the word for which to find similar words (null-terminator is not required)
+ *     word_len: the number of characters in word
+ *     neighbors_dest: the destination in which to store the indices of the best ranked words found
+ *     neighbors_max: the greatest number of indices to store in neighbors_dest
+ * Returns:
+ *     the number of indices stored in neighbors_dest
+ */
+uint8_t app_seedutils_bip39_neighbors(const char *word, uint8_t word_len, uint16_t *neighbors_dest,
+		uint8_t neighbors_max);
+
+/*
+ * Generate the 512-bit seed from the provided BIP 39 mnemonic (with an empty passphrase), as specified by BIP 39. This
+ * is the key stretching step of app_seedutils_compare().
+ *
+ * Args:
+ *     mnemonic: the BIP 39 mnemonic; this may be modified by this function, and should be considered garbage after this
+ *               function returns
+ *     mnemonic_len: the number of chars in mnemonic
+ *     seed_dest: the destination in which to store the 64 byte seed
+ */
+void app_seedutils_bip39_seed(char *mnemonic, uint8_t mnemonic_len, uint8_t *seed_dest);
+
+/*
+ * Derive the BIP 32 master node from the provided BIP 39 seed.
+ *
+ * Args:
+ *     seed: the 64 byte seed, as generated by app_seedutils_bip39_seed()
+ *     node_dest: the destination in which to store the 32 byte private key followed by the 32 byte chain code of the
+ *                node, both big-endian; this may be the same buffer as seed
+ */
+void app_seedutils_derive_master_node(const uint8_t *seed, uint8_t *node_dest);
+
+/*
+ * Derive a descendant of the provided BIP 32 node along a path of hardened child indices. Deriving several paths from
+ * the same master node (or from a shared intermediate node) avoids repeating the key stretching and the derivation of
+ * the shared part of the path.
+ *
+ * Args:
+ *     node: the 64 byte node (private key followed by chain code) from which to derive
+ *     path: the child indices, each of which must be hardened (>= 0x80000000)
+ *     path_len: the number of indices in path; if 0, node is copied to node_dest unchanged
+ *     node_dest: the destination in which to store the 64 byte derived node; this may be the same buffer as node
+ */
+void app_seedutils_derive_path(const uint8_t *node, const uint32_t *path, uint8_t path_len, uint8_t *node_dest);
+
+/*
+ * Determine if the node derived along the provided path from the provided master node is the same as the node derived
+ * along that path from the master seed loaded on the device.
+ *
+ * Args:
+ *     master_node: the 64 byte master node, as derived by app_seedutils_derive_master_node()
+ *     path: the child indices, each of which must be hardened (>= 0x80000000)
+ *     path_len: the number of indices in path; must be at least 1
+ * Returns:
+ *     true if both derived nodes are equal, false otherwise
+ */
+bool app_seedutils_compare_node(const uint8_t *master_node, const uint32_t *path, uint8_t path_len);
+
 /*
  * Determine if the provided BIP 39 mnemonic seed is the same as the master seed loaded on the device.
  *
@@ -81,6 +183,63 @@ uint16_t app_seedutils_bip39_index(const char *word, uint8_t word_len);
  */
 bool app_seedutils_compare(char *mnemonic, uint8_t mnemonic_len);
 
+/*
+ * Compute the fingerprint of a BIP 32 node: the HASH160 (RIPEMD-160 of SHA-256) of the compressed secp256k1 public key
+ * of the node.
+ *
+ * Args:
+ *     node: the 64 byte node (private key followed by chain code); only the private key is used
+ *     fingerprint_dest: the destination in which to store the 20 byte fingerprint
+ */
+void app_seedutils_node_fingerprint(const uint8_t *node, uint8_t *fingerprint_dest);
+
+/*
+ * Compute a public fingerprint of the master seed loaded on the device: the fingerprint, as computed by
+ * app_seedutils_node_fingerprint(), of the node m / 6516080' (hardened), the node compared by app_seedutils_compare().
+ * The same fingerprint can be computed from a backup elsewhere (see tools/fingerprint.c), but neither the node nor the
+ * seed can be recovered from it.
+ *
+ * Args:
+ *     fingerprint_dest: the destination in which to store the 20 byte fingerprint
+ */
+void app_seedutils_device_fingerprint(uint8_t *fingerprint_dest);
+
+/*
+ * Look up every word of the provided space-delimited mnemonic in the BIP 39 English wordlist.
+ *
+ * Args:
+ *     mnemonic: the mnemonic; this must not begin or end with a space, and words must be separated by a single space
+ *     mnemonic_len: the number of chars in mnemonic
+ *     indices_dest: the destination in which to store the index of each word, or 2048 (APP_SEEDUTILS_WORD_COUNT) for
+ *                   each word not found in the wordlist; this must be big enough to store APP_SEEDUTILS_SEED_LENGTH_MAX
+ *                   indices
+ * Returns:
+ *     the number of words in mnemonic, or 0 if mnemonic contains more than APP_SEEDUTILS_SEED_LENGTH_MAX words
+ */
+uint8_t app_seedutils_bip39_indices(const char *mnemonic, uint8_t mnemonic_len, uint16_t *indices_dest);
+
+/*
+ * Pack the provided word indices into the bit array of entropy and checksum they represent. Each index is stored as 11
+ * bits, most significant bit first, starting at the most significant bit of ent_dest[0]. All bits after the last word
+ * are zero.
+ *
+ * Args:
+ *     indices: the word indices; all must be in [0, 2047]
+ *     word_count: the number of indices; in [0, APP_SEEDUTILS_SEED_LENGTH_MAX]
+ *     ent_dest: the destination in which to store the bit array; must be APP_SEEDUTILS_ENT_SIZE bytes
+ */
+void app_seedutils_bip39_pack(const uint16_t *indices, uint8_t word_count, uint8_t *ent_dest);
+
+/*
+ * Unpack word indices from a bit array of entropy and checksum, the inverse of app_seedutils_bip39_pack.
+ *
+ * Args:
+ *     ent: the bit array; must be APP_SEEDUTILS_ENT_SIZE bytes
+ *     word_count: the number of indices to unpack; in [0, APP_SEEDUTILS_SEED_LENGTH_MAX]
+ *     indices_dest: the destination in which to store the word indices, each in [0, 2047]
+ */
+void app_seedutils_bip39_unpack(const uint8_t *ent, uint8_t word_count, uint16_t *indices_dest);
+
 /*
  * Determine if the provided BIP 39 mnemonic seed has a valid checksum. The seed must be a sequence of 12, 18, or 24
  * valid words in the BIP 39 English wordlist, space-delimited.
@@ -88,5 +247,36 @@ bool app_seedutils_compare(char *mnemonic, uint8_t mnemonic_len);
  * Args:
  *     mnemonic: the BIP 39 mnemonic
  *     mnemonic_len: the number of chars in mnemonic
+ * Returns:
+ *     true if mnemonic has a valid checksum, false otherwise
  */
 bool app_seedutils_valid_checksum(const char *mnemonic, uint8_t mnemonic_len);
+
+/*
+ * Determine if the BIP 39 mnemonic seed made of the provided word indices has a valid checksum. This is the same check
+ * as app_seedutils_valid_checksum(), without looking up any words in the wordlist.
+ *
+ * Args:
+ *     indices: the index of every word of the mnemonic in the BIP 39 English wordlist
+ *     word_count: the number of indices; the checksum is only valid if this is 12, 18, or 24
+ * Returns:
+ *     true if the mnemonic has a valid checksum, false otherwise (including if any index is not in [0, 2047])
+ */
+bool app_seedutils_valid_checksum_indices(const uint16_t *indices, uint8_t word_count);
+
+/*
+ * Find the next word which, placed at the specified position of the provided BIP 39 mnemonic seed, gives the mnemonic a
+ * valid checksum. This can be used to recover a single illegible or missing word of a mnemonic by iterating over all
+ * candidates, beginning with start = 0 and continuing with start = the previous result + 1.
+ *
+ * Args:
+ *     indices: the index of every word of the mnemonic in the BIP 39 English wordlist; the index at slot is ignored,
+ *              and all others must be in [0, 2047]
+ *     word_count: the number of indices; 12, 18, or 24
+ *     slot: the position of the word to find; must be less than word_count
+ *     start: the smallest word index to consider; in [0, 2048]
+ * Returns:
+ *     the smallest word index in [start, 2047] that gives the mnemonic a valid checksum, or 2048
+ *     (APP_SEEDUTILS_WORD_COUNT) if there is none
+ */
+uint16_t app_seedutils_checksum_next(const uint16_t *indices, uint8_t word_count, uint8_t slot, uint16_t start);
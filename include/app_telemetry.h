@@ -0,0 +1,141 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef APP_TELEMETRY_H_
+#define APP_TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bui.h"
+
+#include "app.h"
+
+/*
+ * Word entry telemetry, only recorded in debug builds (APP_DEBUG=1). For every word slot of the seed being entered, this
+ * counts button presses, how words were chosen and the frames drawn, and measures the time spent entering the word. For
+ * the session as a whole, this counts the events handled by the room state machine and the frames drawn, and tracks
+ * the peak usage of the room stack. Only word positions and counts are recorded; never any letters or words.
+ */
+
+// The version of the format returned by app_telemetry_dump()
+#define APP_TELEMETRY_VERSION 3
+
+// The maximum number of bytes written by app_telemetry_dump()
+#define APP_TELEMETRY_DUMP_SIZE_MAX (4 + 10 + 24 * 8)
+
+#if APP_DEBUG
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Discard all recorded telemetry and start recording a new seed entry session.
+ *
+ * Args:
+ *     seed_length: the number of words in the seed being entered; 12, 18, or 24
+ */
+void app_telemetry_session_begin(uint8_t seed_length);
+
+/*
+ * Start recording the entry of the word in the specified slot. Time is only measured while a slot is being recorded.
+ *
+ * Args:
+ *     slot: the index of the word in the seed; must be less than the seed length of the current session
+ */
+void app_telemetry_slot_begin(uint8_t slot);
+
+/*
+ * Stop recording the entry of the current word slot, if any.
+ */
+void app_telemetry_slot_end();
+
+/*
+ * Record a button press on the keyboard of the current word slot.
+ *
+ * Args:
+ *     backspace: true if the button press erased a letter, false otherwise
+ */
+void app_telemetry_keystroke(bool backspace);
+
+/*
+ * Record that a word was offered (either as a single prediction or in a list of words) for the current word slot.
+ *
+ * Args:
+ *     accepted: true if the user chose the offered word, false if the user rejected it
+ */
+void app_telemetry_prediction(bool accepted);
+
+/*
+ * Add the specified elapsed time to the dwell time of the current word slot, if any.
+ *
+ * Args:
+ *     elapsed: the number of milliseconds elapsed
+ */
+void app_telemetry_time_elapsed(uint32_t elapsed);
+
+/*
+ * Record that the specified BUI event was handled.
+ *
+ * Args:
+ *     id: the ID of the event
+ */
+void app_telemetry_event(bui_event_id_t id);
+
+/*
+ * Record that a frame was drawn, counting it against the current word slot, if any.
+ */
+void app_telemetry_redraw();
+
+/*
+ * Serialize all recorded telemetry. The format is a 4 byte header (version, seed length, index of the current slot or
+ * 0xFF, reserved), followed by 10 bytes of session counters (BUI_EVENT_DISPLAYED events, BUI_EVENT_TIME_ELAPSED events,
+ * BUI_EVENT_BUTTON_CLICKED events, frames drawn, and peak room stack usage in bytes since the app started as reported
+ * by app_room_ctx_stack_peak(); each big-endian 16 bit), followed by an 8 byte record for every word slot (dwell time
+ * in units of 100 ms, big-endian; visits; keystrokes; backspaces; predictions accepted; predictions rejected; frames
+ * drawn). All counts saturate.
+ *
+ * Args:
+ *     dest: the destination buffer; must be at least APP_TELEMETRY_DUMP_SIZE_MAX bytes
+ * Returns:
+ *     the number of bytes written to dest
+ */
+uint8_t app_telemetry_dump(uint8_t *dest);
+
+#else
+
+#define app_telemetry_session_begin(seed_length) ((void) 0)
+#define app_telemetry_slot_begin(slot) ((void) 0)
+#define app_telemetry_slot_end() ((void) 0)
+#define app_telemetry_keystroke(backspace) ((void) 0)
+#define app_telemetry_prediction(accepted) ((void) 0)
+#define app_telemetry_time_elapsed(elapsed) ((void) 0)
+#define app_telemetry_event(id) ((void) 0)
+#define app_telemetry_redraw() ((void) 0)
+
+#endif
+
+#endif
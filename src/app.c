@@ -34,9 +34,14 @@
 #include "bui_room.h"
 
 #include "app_rooms.h"
+#include "app_telemetry.h"
 
 #define APP_TICKER_INTERVAL 40
 
+// The word with which the unused room stack is painted in debug builds, to measure peak stack usage; data on the stack
+// is far less likely to match an arbitrary 32-bit value than a single repeated byte
+#define APP_ROOM_CTX_STACK_PAINT 0x5EED57AC
+
 //----------------------------------------------------------------------------//
 //                                                                            //
 //                Internal Variable Declarations & Definitions                //
@@ -85,6 +90,12 @@ void app_init() {
 	bui_ctx_init(&app_bui_ctx);
 	bui_ctx_set_event_handler(&app_bui_ctx, app_handle_bui_event);
 	bui_ctx_set_ticker(&app_bui_ctx, APP_TICKER_INTERVAL);
+	app_telemetry_session_begin(0);
+
+#if APP_DEBUG
+	for (uint16_t i = 0; i < sizeof(app_room_ctx_stack) / 4; i++)
+		((uint32_t*) app_room_ctx_stack)[i] = APP_ROOM_CTX_STACK_PAINT;
+#endif
 
 	// Launch the GUI
 	bui_room_ctx_init(&app_room_ctx, app_room_ctx_stack, &app_rooms_main, NULL, 0);
@@ -102,6 +113,16 @@ void app_disp_invalidate() {
 	app_disp_invalidated = true;
 }
 
+#if APP_DEBUG
+uint16_t app_room_ctx_stack_peak() {
+	// The words above the peak are the run of words at the top of the stack that still hold the paint
+	uint16_t words = sizeof(app_room_ctx_stack) / 4;
+	while (words != 0 && ((const uint32_t*) app_room_ctx_stack)[words - 1] == APP_ROOM_CTX_STACK_PAINT)
+		words--;
+	return words * 4;
+}
+#endif
+
 //----------------------------------------------------------------------------//
 //                                                                            //
 //                       Internal Function Definitions                        //
@@ -112,6 +133,7 @@ static void app_handle_bui_event(bui_ctx_t *ctx, const bui_event_t *event) {
 	bui_room_forward_event(&app_room_ctx, event);
 	switch (event->id) {
 	case BUI_EVENT_TIME_ELAPSED: {
+		app_telemetry_time_elapsed(BUI_EVENT_DATA_TIME_ELAPSED(event)->elapsed);
 		if (app_disp_invalidated && bui_ctx_is_displayed(&app_bui_ctx)) {
 			app_display();
 			app_disp_invalidated = false;
@@ -121,9 +143,11 @@ static void app_handle_bui_event(bui_ctx_t *ctx, const bui_event_t *event) {
 	default:
 		break;
 	}
+	app_telemetry_event(event->id);
 }
 
 static void app_display() {
+	app_telemetry_redraw();
 	bui_ctx_fill(&app_bui_ctx, BUI_CLR_BLACK);
 	// Draw the current room by dispatching event BUI_ROOM_EVENT_DRAW
 	{
@@ -37,6 +37,7 @@
 
 #include "app.h"
 #include "app_seedutils.h"
+#include "app_telemetry.h"
 
 /*
  * Room Memory Management Strategy:
@@ -44,19 +45,31 @@
  * This room always has app_room_enterseed_args_t allocated at the bottom of its stack frame, followed by seed_length
  * char buffers of length APP_ROOM_ENTERSEED_WORD_LEN followed by APP_ROOM_ENTERSEED_PAD_LEN padding bytes. Then, it has
  * either app_room_enterseed_active_t or app_room_enterseed_inactive_t allocated at the top of its stack frame,
- * depending on whether or not it is the current room.
+ * depending on whether or not it is the current room. When app_rooms_recoverword returns, its return value is above
+ * app_room_enterseed_inactive_t.
  */
 
 #define APP_ROOM_ENTERSEED_ARGS (*((app_room_enterseed_args_t*) app_room_ctx.frame_ptr))
 #define APP_ROOM_ENTERSEED_WORDS ((char*) (&APP_ROOM_ENTERSEED_ARGS + 1))
 #define APP_ROOM_ENTERSEED_ACTIVE (*((app_room_enterseed_active_t*) (APP_ROOM_ENTERSEED_WORDS + \
 		APP_ROOM_ENTERSEED_WORDS_LEN + APP_ROOM_ENTERSEED_PAD_LEN)))
+#define APP_ROOM_ENTERSEED_INACTIVE (*((app_room_enterseed_inactive_t*) (APP_ROOM_ENTERSEED_WORDS + \
+		APP_ROOM_ENTERSEED_WORDS_LEN + APP_ROOM_ENTERSEED_PAD_LEN)))
 
 #define APP_ROOM_ENTERSEED_PAD_LEN (3 - (APP_ROOM_ENTERSEED_WORDS_LEN + 3) % 4)
 #define APP_ROOM_ENTERSEED_MENU_SIZE (APP_ROOM_ENTERSEED_ARGS.seed_length + 2)
 #define APP_ROOM_ENTERSEED_WORD_LEN (APP_SEEDUTILS_WORD_LEN_MAX + 1)
 #define APP_ROOM_ENTERSEED_WORDS_LEN (APP_ROOM_ENTERSEED_WORD_LEN * APP_ROOM_ENTERSEED_ARGS.seed_length)
 
+#define APP_ROOM_ENTERSEED_SLOT_NONE 0xFF
+
+#if APP_ENTERSEED_SCROLL_ACCEL
+// Clicks in the same direction less than this many milliseconds apart are treated as a repeat
+#define APP_ROOM_ENTERSEED_REPEAT_INTERVAL 400
+// The number of repeated clicks after which each click moves the focus further (2 elements, then 4)
+#define APP_ROOM_ENTERSEED_REPEAT_ACCEL 3
+#endif
+
 //----------------------------------------------------------------------------//
 //                                                                            //
 //                  Internal Type Declarations & Definitions                  //
@@ -65,11 +78,27 @@
 
 typedef struct {
 	bui_menu_menu_t menu;
+	// The position of the word to be recovered by app_rooms_recoverword, or APP_ROOM_ENTERSEED_SLOT_NONE
+	uint8_t recover_slot;
+	// The way in which words are typed in
+	app_room_enterword_mode_t mode;
+#if APP_ENTERSEED_SCROLL_ACCEL
+	// The direction of the last scroll (true if up)
+	bool repeat_up;
+	// The number of consecutive repeated clicks in the direction repeat_up, or 0 if there is no repeat in progress
+	uint8_t repeat_count;
+	// The number of milliseconds since the last scroll, saturating at APP_ROOM_ENTERSEED_REPEAT_INTERVAL
+	uint16_t repeat_elapsed;
+#endif
 } app_room_enterseed_active_t;
 
 typedef struct {
 	// The index of the focused menu element
 	uint8_t focus;
+	// The position of the word being recovered by app_rooms_recoverword, or APP_ROOM_ENTERSEED_SLOT_NONE
+	uint8_t recover_slot;
+	// The way in which words are typed in
+	app_room_enterword_mode_t mode;
 } app_room_enterseed_inactive_t;
 
 //----------------------------------------------------------------------------//
@@ -89,7 +118,14 @@ static void app_room_enterseed_button_clicked(bui_button_id_t button);
 static uint8_t app_room_enterseed_elem_size(const bui_menu_menu_t *menu, uint8_t i);
 static void app_room_enterseed_elem_draw(const bui_menu_menu_t *menu, uint8_t i, bui_ctx_t *bui_ctx, int16_t y);
 
-static bool app_room_enterseed_everything_entered();
+static void app_room_enterseed_scroll(bool up);
+static void app_room_enterseed_enter_word(uint8_t slot);
+#if APP_ENTERSEED_AUTO_ADVANCE
+static uint8_t app_room_enterseed_next_empty_slot(uint8_t slot);
+#endif
+static uint8_t app_room_enterseed_missing_slot();
+static uint8_t app_room_enterseed_word_len(uint8_t slot);
+static void app_room_enterseed_set_word(uint8_t slot, uint16_t word_index);
 
 //----------------------------------------------------------------------------//
 //                                                                            //
@@ -141,27 +177,62 @@ static void app_room_enterseed_handle_event(bui_room_ctx_t *ctx, const bui_room_
 
 static void app_room_enterseed_enter(bool up) {
 	uint8_t focus;
+	app_room_enterword_mode_t mode;
+	uint8_t advance = APP_ROOM_ENTERSEED_SLOT_NONE;
 	if (up) {
 		bui_room_alloc(&app_room_ctx, APP_ROOM_ENTERSEED_WORDS_LEN);
 		os_memset(APP_ROOM_ENTERSEED_WORDS, 0, APP_ROOM_ENTERSEED_WORDS_LEN);
 		bui_room_alloc(&app_room_ctx, APP_ROOM_ENTERSEED_PAD_LEN);
+		if (APP_ROOM_ENTERSEED_ARGS.indices != NULL) {
+			for (uint8_t i = 0; i < APP_ROOM_ENTERSEED_ARGS.seed_length; i++)
+				app_room_enterseed_set_word(i, APP_ROOM_ENTERSEED_ARGS.indices[i]);
+		}
 		focus = 0;
+		mode = APP_ROOM_ENTERWORD_MODE_LETTERS;
+		app_telemetry_session_begin(APP_ROOM_ENTERSEED_ARGS.seed_length);
 	} else {
+		app_telemetry_slot_end();
+		if (APP_ROOM_ENTERSEED_INACTIVE.recover_slot != APP_ROOM_ENTERSEED_SLOT_NONE) {
+			app_room_recoverword_ret_t recoverword_ret;
+			bui_room_pop(&app_room_ctx, &recoverword_ret, sizeof(recoverword_ret));
+			if (recoverword_ret.word_index != APP_SEEDUTILS_WORD_COUNT)
+				app_room_enterseed_set_word(APP_ROOM_ENTERSEED_INACTIVE.recover_slot, recoverword_ret.word_index);
+		}
 		app_room_enterseed_inactive_t inactive;
 		bui_room_pop(&app_room_ctx, &inactive, sizeof(inactive));
 		focus = inactive.focus;
+		mode = inactive.mode;
+#if APP_ENTERSEED_AUTO_ADVANCE
+		// If a word was just entered, move on to the next word not entered yet, or to "Done" if there is none
+		if (inactive.recover_slot == APP_ROOM_ENTERSEED_SLOT_NONE && focus != 0 &&
+				focus != APP_ROOM_ENTERSEED_MENU_SIZE - 1 &&
+				APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * (focus - 1)] != '\0') {
+			advance = app_room_enterseed_next_empty_slot(focus - 1);
+			focus = advance != APP_ROOM_ENTERSEED_SLOT_NONE ? advance + 1 : APP_ROOM_ENTERSEED_MENU_SIZE - 1;
+		}
+#endif
 	}
 	bui_room_alloc(&app_room_ctx, sizeof(app_room_enterseed_active_t));
 	APP_ROOM_ENTERSEED_ACTIVE.menu.elem_size_callback = app_room_enterseed_elem_size;
 	APP_ROOM_ENTERSEED_ACTIVE.menu.elem_draw_callback = app_room_enterseed_elem_draw;
+	APP_ROOM_ENTERSEED_ACTIVE.recover_slot = APP_ROOM_ENTERSEED_SLOT_NONE;
+	APP_ROOM_ENTERSEED_ACTIVE.mode = mode;
+#if APP_ENTERSEED_SCROLL_ACCEL
+	APP_ROOM_ENTERSEED_ACTIVE.repeat_count = 0;
+	APP_ROOM_ENTERSEED_ACTIVE.repeat_elapsed = APP_ROOM_ENTERSEED_REPEAT_INTERVAL;
+#endif
 	bui_menu_init(&APP_ROOM_ENTERSEED_ACTIVE.menu, APP_ROOM_ENTERSEED_MENU_SIZE, focus, true);
 	app_disp_invalidate();
+	if (advance != APP_ROOM_ENTERSEED_SLOT_NONE)
+		app_room_enterseed_enter_word(advance);
 }
 
 static void app_room_enterseed_exit(bool up) {
 	if (up) {
 		app_room_enterseed_inactive_t inactive;
 		inactive.focus = bui_menu_get_focused(&APP_ROOM_ENTERSEED_ACTIVE.menu);
+		inactive.recover_slot = APP_ROOM_ENTERSEED_ACTIVE.recover_slot;
+		inactive.mode = APP_ROOM_ENTERSEED_ACTIVE.mode;
 		bui_room_dealloc(&app_room_ctx, sizeof(app_room_enterseed_active_t));
 		bui_room_push(&app_room_ctx, &inactive, sizeof(inactive));
 	} else {
@@ -171,9 +242,7 @@ static void app_room_enterseed_exit(bool up) {
 		char *mnemonic = app_room_ctx.frame_ptr;
 		uint8_t mnemonic_len = 0;
 		for (uint8_t i = 0; i < seed_length; i++) {
-			uint8_t word_len = 0;
-			for (char *ch = &words[APP_ROOM_ENTERSEED_WORD_LEN * i]; *ch != '\0'; ch++)
-				word_len++;
+			uint8_t word_len = app_room_enterseed_word_len(i);
 			os_memmove(&mnemonic[mnemonic_len], &words[APP_ROOM_ENTERSEED_WORD_LEN * i], word_len);
 			mnemonic_len += word_len;
 			mnemonic[mnemonic_len++] = i + 1 != seed_length ? ' ' : '\0';
@@ -187,6 +256,13 @@ static void app_room_enterseed_draw() {
 }
 
 static void app_room_enterseed_time_elapsed(uint32_t elapsed) {
+#if APP_ENTERSEED_SCROLL_ACCEL
+	uint32_t repeat_elapsed = APP_ROOM_ENTERSEED_ACTIVE.repeat_elapsed + elapsed;
+	if (repeat_elapsed >= APP_ROOM_ENTERSEED_REPEAT_INTERVAL)
+		APP_ROOM_ENTERSEED_ACTIVE.repeat_elapsed = APP_ROOM_ENTERSEED_REPEAT_INTERVAL;
+	else
+		APP_ROOM_ENTERSEED_ACTIVE.repeat_elapsed = repeat_elapsed;
+#endif
 	if (bui_menu_animate(&APP_ROOM_ENTERSEED_ACTIVE.menu, elapsed))
 		app_disp_invalidate();
 }
@@ -196,10 +272,26 @@ static void app_room_enterseed_button_clicked(bui_button_id_t button) {
 	case BUI_BUTTON_NANOS_BOTH: {
 		uint8_t focused = bui_menu_get_focused(&APP_ROOM_ENTERSEED_ACTIVE.menu);
 		if (focused == 0) { // "Type in your seed" prompt was selected
-			// Do nothing
+			// Switch to the next way of typing in words
+			APP_ROOM_ENTERSEED_ACTIVE.mode = (APP_ROOM_ENTERSEED_ACTIVE.mode + 1) % APP_ROOM_ENTERWORD_MODE_COUNT;
+			app_disp_invalidate();
 		} else if (focused == APP_ROOM_ENTERSEED_MENU_SIZE - 1) { // "Done" was selected
-			if (app_room_enterseed_everything_entered()) {
+			uint8_t missing = app_room_enterseed_missing_slot();
+			if (missing == APP_ROOM_ENTERSEED_SLOT_NONE) {
 				bui_room_exit(&app_room_ctx);
+			} else if (missing != APP_ROOM_ENTERSEED_ARGS.seed_length) {
+				// Exactly one word is missing; offer the words that would give the seed a valid checksum
+				app_room_recoverword_args_t args = {
+					.word_count = APP_ROOM_ENTERSEED_ARGS.seed_length,
+					.slot = missing,
+				};
+				for (uint8_t i = 0; i < args.word_count; i++) {
+					const char *word = &APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * i];
+					uint8_t word_len = app_room_enterseed_word_len(i);
+					args.indices[i] = i == missing ? 0 : app_seedutils_bip39_index(word, word_len);
+				}
+				APP_ROOM_ENTERSEED_ACTIVE.recover_slot = missing;
+				bui_room_enter(&app_room_ctx, &app_rooms_recoverword, &args, sizeof(args));
 			} else {
 				bui_room_message_args_t args = {
 					.msg = "Not all words\nhave been entered.",
@@ -209,19 +301,14 @@ static void app_room_enterseed_button_clicked(bui_button_id_t button) {
 				bui_room_enter(&app_room_ctx, &bui_room_message, &args, sizeof(args));
 			}
 		} else { // A word was selected
-			app_room_enterword_args_t args = {
-				.word_buff = &APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * (focused - 1)],
-			};
-			bui_room_enter(&app_room_ctx, &app_rooms_enterword, &args, sizeof(args));
+			app_room_enterseed_enter_word(focused - 1);
 		}
 	} break;
 	case BUI_BUTTON_NANOS_LEFT:
-		bui_menu_scroll(&APP_ROOM_ENTERSEED_ACTIVE.menu, true);
-		app_disp_invalidate();
+		app_room_enterseed_scroll(true);
 		break;
 	case BUI_BUTTON_NANOS_RIGHT:
-		bui_menu_scroll(&APP_ROOM_ENTERSEED_ACTIVE.menu, false);
-		app_disp_invalidate();
+		app_room_enterseed_scroll(false);
 		break;
 	}
 }
@@ -237,8 +324,28 @@ static uint8_t app_room_enterseed_elem_size(const bui_menu_menu_t *menu, uint8_t
 
 static void app_room_enterseed_elem_draw(const bui_menu_menu_t *menu, uint8_t i, bui_ctx_t *bui_ctx, int16_t y) {
 	if (i == 0) {
-		bui_font_draw_string(&app_bui_ctx, "Type in your", 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
-		bui_font_draw_string(&app_bui_ctx, "seed below:", 64, y + 14, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+		const char *line1;
+		const char *line2;
+		switch (APP_ROOM_ENTERSEED_ACTIVE.mode) {
+		case APP_ROOM_ENTERWORD_MODE_LETTERS:
+			line1 = "Type in your";
+			line2 = "seed below:";
+			break;
+		case APP_ROOM_ENTERWORD_MODE_NUMBER:
+			line1 = "Type in your seed";
+			line2 = "as word numbers:";
+			break;
+		case APP_ROOM_ENTERWORD_MODE_BITS:
+			line1 = "Type in your seed";
+			line2 = "as 11 bit indices:";
+			break;
+		default:
+			line1 = "Type in your seed";
+			line2 = "as it is written:";
+			break;
+		}
+		bui_font_draw_string(&app_bui_ctx, line1, 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+		bui_font_draw_string(&app_bui_ctx, line2, 64, y + 14, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
 	} else if (i == APP_ROOM_ENTERSEED_MENU_SIZE - 1) {
 		bui_font_draw_string(&app_bui_ctx, "Done", 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
 	} else {
@@ -256,10 +363,131 @@ static void app_room_enterseed_elem_draw(const bui_menu_menu_t *menu, uint8_t i,
 	}
 }
 
-static bool app_room_enterseed_everything_entered() {
+/*
+ * Move the menu focus by one element. If APP_ENTERSEED_SCROLL_ACCEL is enabled and the user is clicking repeatedly in
+ * the same direction, the focus keeps moving over up to three more empty word slots, so that every word that has been
+ * entered is still shown while scrolling; moves of more than one element re-initialize the menu at the new focus,
+ * skipping the scroll animation.
+ *
+ * Args:
+ *     up: true to move the focus up, false to move it down
+ */
+static void app_room_enterseed_scroll(bool up) {
+#if APP_ENTERSEED_SCROLL_ACCEL
+	if (APP_ROOM_ENTERSEED_ACTIVE.repeat_count != 0 && APP_ROOM_ENTERSEED_ACTIVE.repeat_up == up &&
+			APP_ROOM_ENTERSEED_ACTIVE.repeat_elapsed < APP_ROOM_ENTERSEED_REPEAT_INTERVAL) {
+		if (APP_ROOM_ENTERSEED_ACTIVE.repeat_count != 0xFF)
+			APP_ROOM_ENTERSEED_ACTIVE.repeat_count++;
+	} else {
+		APP_ROOM_ENTERSEED_ACTIVE.repeat_up = up;
+		APP_ROOM_ENTERSEED_ACTIVE.repeat_count = 1;
+	}
+	APP_ROOM_ENTERSEED_ACTIVE.repeat_elapsed = 0;
+	uint8_t step;
+	if (APP_ROOM_ENTERSEED_ACTIVE.repeat_count <= APP_ROOM_ENTERSEED_REPEAT_ACCEL)
+		step = 1;
+	else if (APP_ROOM_ENTERSEED_ACTIVE.repeat_count <= APP_ROOM_ENTERSEED_REPEAT_ACCEL * 2)
+		step = 2;
+	else
+		step = 4;
+	// Menu element i in [1, seed_length] is the word at position i - 1; the move stops at the first element that is
+	// not an empty word slot
+	uint8_t focus = bui_menu_get_focused(&APP_ROOM_ENTERSEED_ACTIVE.menu);
+	uint8_t target = focus;
+	for (uint8_t moved = 0; moved < step; moved++) {
+		if (up ? target == 0 : target == APP_ROOM_ENTERSEED_MENU_SIZE - 1)
+			break;
+		target = up ? target - 1 : target + 1;
+		if (target == 0 || target > APP_ROOM_ENTERSEED_ARGS.seed_length ||
+				APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * (target - 1)] != '\0')
+			break;
+	}
+	if (target != focus && target != (up ? focus - 1 : focus + 1)) {
+		bui_menu_init(&APP_ROOM_ENTERSEED_ACTIVE.menu, APP_ROOM_ENTERSEED_MENU_SIZE, target, true);
+		app_disp_invalidate();
+		return;
+	}
+#endif
+	bui_menu_scroll(&APP_ROOM_ENTERSEED_ACTIVE.menu, up);
+	app_disp_invalidate();
+}
+
+/*
+ * Enter app_rooms_enterword to enter (or replace) the word at the specified position.
+ *
+ * Args:
+ *     slot: the position of the word; in [0, seed_length)
+ */
+static void app_room_enterseed_enter_word(uint8_t slot) {
+	app_room_enterword_args_t args = {
+		.word_buff = &APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * slot],
+		.mode = APP_ROOM_ENTERSEED_ACTIVE.mode,
+	};
+	app_telemetry_slot_begin(slot);
+	bui_room_enter(&app_room_ctx, &app_rooms_enterword, &args, sizeof(args));
+}
+
+#if APP_ENTERSEED_AUTO_ADVANCE
+
+/*
+ * Find the first word not entered yet after the specified position, wrapping around to the first word.
+ *
+ * Args:
+ *     slot: the position after which to search; in [0, seed_length)
+ * Returns:
+ *     the position of the word, or APP_ROOM_ENTERSEED_SLOT_NONE if every other word has been entered
+ */
+static uint8_t app_room_enterseed_next_empty_slot(uint8_t slot) {
+	uint8_t seed_length = APP_ROOM_ENTERSEED_ARGS.seed_length;
+	for (uint8_t i = 1; i < seed_length; i++) {
+		uint8_t next = (slot + i) % seed_length;
+		if (APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * next] == '\0')
+			return next;
+	}
+	return APP_ROOM_ENTERSEED_SLOT_NONE;
+}
+
+#endif
+
+/*
+ * Find the word that has not been entered yet, if there is exactly one.
+ *
+ * Returns:
+ *     the position of the only word not entered yet, APP_ROOM_ENTERSEED_SLOT_NONE if every word has been entered, or
+ *     the seed length if more than one word has not been entered yet
+ */
+static uint8_t app_room_enterseed_missing_slot() {
+	uint8_t missing = APP_ROOM_ENTERSEED_SLOT_NONE;
 	for (uint8_t i = 0; i < APP_ROOM_ENTERSEED_ARGS.seed_length; i++) {
-		if (APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * i] == '\0')
-			return false;
+		if (APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * i] == '\0') {
+			if (missing != APP_ROOM_ENTERSEED_SLOT_NONE)
+				return APP_ROOM_ENTERSEED_ARGS.seed_length;
+			missing = i;
+		}
 	}
-	return true;
+	return missing;
+}
+
+/*
+ * Get the length of the word at the specified position.
+ *
+ * Args:
+ *     slot: the position of the word; in [0, seed_length)
+ * Returns:
+ *     the number of characters in the word, or 0 if it has not been entered
+ */
+static uint8_t app_room_enterseed_word_len(uint8_t slot) {
+	const char *word = &APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * slot];
+	uint8_t word_len = 0;
+	while (word_len < APP_SEEDUTILS_WORD_LEN_MAX && word[word_len] != '\0')
+		word_len++;
+	return word_len;
+}
+
+static void app_room_enterseed_set_word(uint8_t slot, uint16_t word_index) {
+	char *word_buff = &APP_ROOM_ENTERSEED_WORDS[APP_ROOM_ENTERSEED_WORD_LEN * slot];
+	uint8_t word_len;
+	const char *word = app_seedutils_bip39_word(word_index, &word_len);
+	os_memcpy(word_buff, word, word_len);
+	word_buff[word_len] = '\0';
 }
@@ -36,11 +36,15 @@
 
 #include "app.h"
 #include "app_seedutils.h"
+#include "app_telemetry.h"
 
 #define APP_ROOM_ENTERWORD_ARGS (*((app_room_enterword_args_t*) app_room_ctx.frame_ptr))
 #define APP_ROOM_ENTERWORD_ACTIVE (*((app_room_enterword_active_t*) (&APP_ROOM_ENTERWORD_ARGS + 1)))
 #define APP_ROOM_ENTERWORD_INACTIVE (*((app_room_enterword_inactive_t*) (&APP_ROOM_ENTERWORD_ARGS + 1)))
 
+// The greatest number of similar words suggested for a misspelled word (APP_ROOM_ENTERWORD_MODE_FREE)
+#define APP_ROOM_ENTERWORD_SUGGESTIONS_MAX 8
+
 //----------------------------------------------------------------------------//
 //                                                                            //
 //                  Internal Type Declarations & Definitions                  //
@@ -50,14 +54,29 @@
 typedef struct {
 	bui_bkb_bkb_t bkb;
 	bool ready;
+	// The digits typed in, if the word is typed in as a number (APP_ROOM_ENTERWORD_MODE_NUMBER or
+	// APP_ROOM_ENTERWORD_MODE_BITS); not null-terminated
+	char digits[11];
 } app_room_enterword_active_t;
 
-// NOTE: This room is only inactive when confirming a word prediction.
+typedef uint8_t app_room_enterword_child_t;
+#define APP_ROOM_ENTERWORD_CHILD_CONFIRM  ((app_room_enterword_child_t) 0) // A single word is being confirmed
+#define APP_ROOM_ENTERWORD_CHILD_PICKWORD ((app_room_enterword_child_t) 1) // A list of words is being picked from
+#define APP_ROOM_ENTERWORD_CHILD_MESSAGE  ((app_room_enterword_child_t) 2) // No similar words were found
+
+// NOTE: This room is only inactive when confirming a word prediction, picking from a list of words, or showing that no
+// words similar to a misspelled word were found.
 typedef struct {
+	// The room that was entered
+	app_room_enterword_child_t child;
+	// The number of letters typed in when the room was deactivated
+	uint8_t typed_len;
 	// The index of the word being predicted
 	uint16_t word_index;
 	// The predicted word as a null-terminated string
 	char word[APP_SEEDUTILS_WORD_LEN_MAX + 1];
+	// The indices of the words suggested for a misspelled word
+	uint16_t suggestions[APP_ROOM_ENTERWORD_SUGGESTIONS_MAX];
 } app_room_enterword_inactive_t;
 
 //----------------------------------------------------------------------------//
@@ -75,6 +94,10 @@ static void app_room_enterword_time_elapsed(uint32_t elapsed);
 static void app_room_enterword_button_clicked(bui_button_id_t button);
 
 static void app_room_enterword_update_bkb();
+static void app_room_enterword_update_bkb_number();
+static uint16_t app_room_enterword_typed_index();
+static void app_room_enterword_confirm(uint16_t word_index);
+static void app_room_enterword_suggest();
 
 //----------------------------------------------------------------------------//
 //                                                                            //
@@ -125,10 +148,27 @@ static void app_room_enterword_handle_event(bui_room_ctx_t *ctx, const bui_room_
 }
 
 static void app_room_enterword_enter(bool up) {
+	uint8_t typed_len = 0;
 	if (!up) {
-		bui_room_confirm_ret_t confirm_ret;
-		bui_room_pop(&app_room_ctx, &confirm_ret, sizeof(confirm_ret));
-		if (confirm_ret.confirmed) {
+		bool chosen = false;
+		switch (APP_ROOM_ENTERWORD_INACTIVE.child) {
+		case APP_ROOM_ENTERWORD_CHILD_CONFIRM: {
+			bui_room_confirm_ret_t confirm_ret;
+			bui_room_pop(&app_room_ctx, &confirm_ret, sizeof(confirm_ret));
+			chosen = confirm_ret.confirmed;
+			app_telemetry_prediction(chosen);
+		} break;
+		case APP_ROOM_ENTERWORD_CHILD_PICKWORD: {
+			app_room_pickword_ret_t pickword_ret;
+			bui_room_pop(&app_room_ctx, &pickword_ret, sizeof(pickword_ret));
+			chosen = pickword_ret.word_index != APP_SEEDUTILS_WORD_COUNT;
+			APP_ROOM_ENTERWORD_INACTIVE.word_index = pickword_ret.word_index;
+			app_telemetry_prediction(chosen);
+		} break;
+		case APP_ROOM_ENTERWORD_CHILD_MESSAGE:
+			break;
+		}
+		if (chosen) {
 			uint8_t word_len;
 			const char *word = app_seedutils_bip39_word(APP_ROOM_ENTERWORD_INACTIVE.word_index, &word_len);
 			os_memcpy(APP_ROOM_ENTERWORD_ARGS.word_buff, word, word_len);
@@ -136,11 +176,28 @@ static void app_room_enterword_enter(bool up) {
 			bui_room_exit(&app_room_ctx);
 			return;
 		}
+		// A misspelled word is kept so that it can be corrected
+		if (APP_ROOM_ENTERWORD_ARGS.mode == APP_ROOM_ENTERWORD_MODE_FREE)
+			typed_len = APP_ROOM_ENTERWORD_INACTIVE.typed_len;
 		bui_room_dealloc(&app_room_ctx, sizeof(app_room_enterword_inactive_t));
 	}
 	bui_room_alloc(&app_room_ctx, sizeof(app_room_enterword_active_t));
-	bui_bkb_init(&APP_ROOM_ENTERWORD_ACTIVE.bkb, NULL, 0, APP_ROOM_ENTERWORD_ARGS.word_buff, 0,
-			APP_SEEDUTILS_WORD_LEN_MAX, true);
+	switch (APP_ROOM_ENTERWORD_ARGS.mode) {
+	case APP_ROOM_ENTERWORD_MODE_LETTERS:
+		bui_bkb_init(&APP_ROOM_ENTERWORD_ACTIVE.bkb, NULL, 0, APP_ROOM_ENTERWORD_ARGS.word_buff, 0,
+				APP_SEEDUTILS_WORD_LEN_MAX, true);
+		break;
+	case APP_ROOM_ENTERWORD_MODE_NUMBER:
+		bui_bkb_init(&APP_ROOM_ENTERWORD_ACTIVE.bkb, NULL, 0, APP_ROOM_ENTERWORD_ACTIVE.digits, 0, 4, true);
+		break;
+	case APP_ROOM_ENTERWORD_MODE_BITS:
+		bui_bkb_init(&APP_ROOM_ENTERWORD_ACTIVE.bkb, NULL, 0, APP_ROOM_ENTERWORD_ACTIVE.digits, 0, 11, true);
+		break;
+	case APP_ROOM_ENTERWORD_MODE_FREE:
+		bui_bkb_init(&APP_ROOM_ENTERWORD_ACTIVE.bkb, NULL, 0, APP_ROOM_ENTERWORD_ARGS.word_buff, typed_len,
+				APP_SEEDUTILS_WORD_LEN_MAX, true);
+		break;
+	}
 	app_room_enterword_update_bkb();
 	app_disp_invalidate();
 }
@@ -166,6 +223,14 @@ static void app_room_enterword_button_clicked(bui_button_id_t button) {
 	case BUI_BUTTON_NANOS_BOTH:
 		if (APP_ROOM_ENTERWORD_ACTIVE.ready) {
 			uint8_t type_buff_size = bui_bkb_get_type_buff_size(&APP_ROOM_ENTERWORD_ACTIVE.bkb);
+			if (APP_ROOM_ENTERWORD_ARGS.mode == APP_ROOM_ENTERWORD_MODE_FREE && type_buff_size != 0) {
+				app_room_enterword_suggest();
+				return;
+			}
+			if (APP_ROOM_ENTERWORD_ARGS.mode != APP_ROOM_ENTERWORD_MODE_LETTERS && type_buff_size != 0) {
+				app_room_enterword_confirm(app_room_enterword_typed_index());
+				return;
+			}
 			APP_ROOM_ENTERWORD_ARGS.word_buff[type_buff_size] = '\0';
 			bui_room_exit(&app_room_ctx);
 		}
@@ -179,36 +244,178 @@ static void app_room_enterword_button_clicked(bui_button_id_t button) {
 	}
 	// Control only reaches here if the left or right button was clicked (not both)
 	int choice = bui_bkb_choose(&APP_ROOM_ENTERWORD_ACTIVE.bkb, dir);
+	app_telemetry_keystroke(choice == 0x2FF);
 	if (choice <= 0xFF || choice == 0x2FF)
 		app_room_enterword_update_bkb();
 	app_disp_invalidate();
 }
 
 static void app_room_enterword_update_bkb() {
+	if (APP_ROOM_ENTERWORD_ARGS.mode == APP_ROOM_ENTERWORD_MODE_FREE) {
+		// Any letter may be typed in, since the word may be misspelled
+		uint8_t type_buff_size = bui_bkb_get_type_buff_size(&APP_ROOM_ENTERWORD_ACTIVE.bkb);
+		APP_ROOM_ENTERWORD_ACTIVE.ready = true;
+		bui_bkb_set_layout(&APP_ROOM_ENTERWORD_ACTIVE.bkb, "abcdefghijklmnopqrstuvwxyz",
+				type_buff_size < APP_SEEDUTILS_WORD_LEN_MAX ? 26 : 0);
+		return;
+	}
+	if (APP_ROOM_ENTERWORD_ARGS.mode != APP_ROOM_ENTERWORD_MODE_LETTERS) {
+		app_room_enterword_update_bkb_number();
+		return;
+	}
 	uint8_t type_buff_size = bui_bkb_get_type_buff_size(&APP_ROOM_ENTERWORD_ACTIVE.bkb);
+	uint16_t *counts = bui_room_alloc(&app_room_ctx, 26 * sizeof(uint16_t));
 	char *layout = bui_room_alloc(&app_room_ctx, 26);
 	bool complete;
 	int16_t prediction;
 	uint8_t layout_size = app_seedutils_bip39_next_letters(APP_ROOM_ENTERWORD_ARGS.word_buff, type_buff_size, layout,
-			&complete, &prediction);
+			counts, &complete, &prediction);
 	if (prediction != -1) {
 		bui_room_dealloc(&app_room_ctx, 26);
-		uint8_t word_len;
-		const char *word = app_seedutils_bip39_word(prediction, &word_len);
+		bui_room_dealloc(&app_room_ctx, 26 * sizeof(uint16_t));
+		app_room_enterword_confirm(prediction);
+		return;
+	}
+#if APP_ENTERWORD_PICK_MAX > 1
+	// The number of words beginning with the typed prefix is known from the letter counts, so the wordlist only needs to
+	// be searched again for the first such word if a list is to be offered
+	uint16_t count = complete ? 1 : 0;
+	for (uint8_t i = 0; i < layout_size; i++)
+		count += counts[i];
+	if (count > 1 && count <= APP_ENTERWORD_PICK_MAX) {
+		uint16_t first;
+		app_seedutils_bip39_prefix_range(APP_ROOM_ENTERWORD_ARGS.word_buff, type_buff_size, &first);
+		bui_room_dealloc(&app_room_ctx, 26);
+		bui_room_dealloc(&app_room_ctx, 26 * sizeof(uint16_t));
 		bui_room_dealloc(&app_room_ctx, sizeof(app_room_enterword_active_t));
 		bui_room_alloc(&app_room_ctx, sizeof(app_room_enterword_inactive_t));
-		APP_ROOM_ENTERWORD_INACTIVE.word_index = prediction;
-		os_memcpy(APP_ROOM_ENTERWORD_INACTIVE.word, word, word_len);
-		APP_ROOM_ENTERWORD_INACTIVE.word[word_len] = '\0';
-		bui_room_confirm_args_t args = {
-			.msg = APP_ROOM_ENTERWORD_INACTIVE.word,
-			.font = bui_font_open_sans_extrabold_11,
+		APP_ROOM_ENTERWORD_INACTIVE.child = APP_ROOM_ENTERWORD_CHILD_PICKWORD;
+		app_room_pickword_args_t args = {
+			.first = first,
+			.count = count,
+			.words = NULL,
 		};
 		app_disp_invalidate();
-		bui_room_enter(&app_room_ctx, &bui_room_confirm, &args, sizeof(args));
+		bui_room_enter(&app_room_ctx, &app_rooms_pickword, &args, sizeof(args));
 		return;
 	}
+#endif
 	APP_ROOM_ENTERWORD_ACTIVE.ready = type_buff_size == 0 || complete;
+#if APP_ENTERWORD_WEIGHTED_LAYOUT
+	app_seedutils_order_letters(layout, counts, layout_size);
+#endif
 	bui_bkb_set_layout(&APP_ROOM_ENTERWORD_ACTIVE.bkb, layout, layout_size);
 	bui_room_dealloc(&app_room_ctx, 26);
+	bui_room_dealloc(&app_room_ctx, 26 * sizeof(uint16_t));
+}
+
+/*
+ * Update the keyboard when the word is typed in as a number. Only digits that can still lead to a word number are
+ * offered, and once no more digits can be typed in the word is offered for confirmation right away.
+ */
+static void app_room_enterword_update_bkb_number() {
+	uint8_t type_buff_size = bui_bkb_get_type_buff_size(&APP_ROOM_ENTERWORD_ACTIVE.bkb);
+	bool bits = APP_ROOM_ENTERWORD_ARGS.mode == APP_ROOM_ENTERWORD_MODE_BITS;
+	uint8_t base = bits ? 2 : 10;
+	uint16_t value = 0;
+	for (uint8_t i = 0; i < type_buff_size; i++)
+		value = value * base + (APP_ROOM_ENTERWORD_ACTIVE.digits[i] - '0');
+	char layout[10];
+	uint8_t layout_size = 0;
+	for (uint8_t digit = 0; digit < base; digit++) {
+		// Words are numbered from 1 to 2048, while their 11 bit indices range from 0 to 2047
+		uint16_t next = value * base + digit;
+		if (bits ? type_buff_size < 11 : next >= 1 && next <= APP_SEEDUTILS_WORD_COUNT)
+			layout[layout_size++] = '0' + digit;
+	}
+	if (layout_size == 0) {
+		app_room_enterword_confirm(app_room_enterword_typed_index());
+		return;
+	}
+	APP_ROOM_ENTERWORD_ACTIVE.ready = type_buff_size == 0 || app_room_enterword_typed_index() != APP_SEEDUTILS_WORD_COUNT;
+	bui_bkb_set_layout(&APP_ROOM_ENTERWORD_ACTIVE.bkb, layout, layout_size);
+}
+
+/*
+ * Get the index of the word whose number has been typed in, when the word is typed in as a number.
+ *
+ * Returns:
+ *     the index of the word in the wordlist, or 2048 (APP_SEEDUTILS_WORD_COUNT) if the digits typed in so far are not
+ *     the number of a word
+ */
+static uint16_t app_room_enterword_typed_index() {
+	uint8_t type_buff_size = bui_bkb_get_type_buff_size(&APP_ROOM_ENTERWORD_ACTIVE.bkb);
+	bool bits = APP_ROOM_ENTERWORD_ARGS.mode == APP_ROOM_ENTERWORD_MODE_BITS;
+	uint16_t value = 0;
+	for (uint8_t i = 0; i < type_buff_size; i++)
+		value = value * (bits ? 2 : 10) + (APP_ROOM_ENTERWORD_ACTIVE.digits[i] - '0');
+	if (bits)
+		return type_buff_size == 11 ? value : APP_SEEDUTILS_WORD_COUNT;
+	return value >= 1 && value <= APP_SEEDUTILS_WORD_COUNT ? value - 1 : APP_SEEDUTILS_WORD_COUNT;
+}
+
+/*
+ * Deactivate the keyboard and ask the user to confirm the specified word.
+ *
+ * Args:
+ *     word_index: the index of the word in the wordlist; must be in [0, 2047]
+ */
+static void app_room_enterword_confirm(uint16_t word_index) {
+	uint8_t word_len;
+	const char *word = app_seedutils_bip39_word(word_index, &word_len);
+	uint8_t typed_len = bui_bkb_get_type_buff_size(&APP_ROOM_ENTERWORD_ACTIVE.bkb);
+	bui_room_dealloc(&app_room_ctx, sizeof(app_room_enterword_active_t));
+	bui_room_alloc(&app_room_ctx, sizeof(app_room_enterword_inactive_t));
+	APP_ROOM_ENTERWORD_INACTIVE.child = APP_ROOM_ENTERWORD_CHILD_CONFIRM;
+	APP_ROOM_ENTERWORD_INACTIVE.typed_len = typed_len;
+	APP_ROOM_ENTERWORD_INACTIVE.word_index = word_index;
+	os_memcpy(APP_ROOM_ENTERWORD_INACTIVE.word, word, word_len);
+	APP_ROOM_ENTERWORD_INACTIVE.word[word_len] = '\0';
+	bui_room_confirm_args_t args = {
+		.msg = APP_ROOM_ENTERWORD_INACTIVE.word,
+		.font = bui_font_open_sans_extrabold_11,
+	};
+	app_disp_invalidate();
+	bui_room_enter(&app_room_ctx, &bui_room_confirm, &args, sizeof(args));
+}
+
+/*
+ * Look up the word typed in when any letters may be typed in (APP_ROOM_ENTERWORD_MODE_FREE). If it is in the wordlist it
+ * is confirmed; otherwise, the words a single edit away from it are offered instead.
+ */
+static void app_room_enterword_suggest() {
+	const char *typed = APP_ROOM_ENTERWORD_ARGS.word_buff;
+	uint8_t typed_len = bui_bkb_get_type_buff_size(&APP_ROOM_ENTERWORD_ACTIVE.bkb);
+	uint16_t word_index = app_seedutils_bip39_index(typed, typed_len);
+	if (word_index != APP_SEEDUTILS_WORD_COUNT) {
+		app_room_enterword_confirm(word_index);
+		return;
+	}
+	uint16_t suggestions[APP_ROOM_ENTERWORD_SUGGESTIONS_MAX];
+	uint8_t count = app_seedutils_bip39_neighbors(typed, typed_len, suggestions, APP_ROOM_ENTERWORD_SUGGESTIONS_MAX);
+	if (count == 1) {
+		app_room_enterword_confirm(suggestions[0]);
+		return;
+	}
+	bui_room_dealloc(&app_room_ctx, sizeof(app_room_enterword_active_t));
+	bui_room_alloc(&app_room_ctx, sizeof(app_room_enterword_inactive_t));
+	APP_ROOM_ENTERWORD_INACTIVE.typed_len = typed_len;
+	app_disp_invalidate();
+	if (count == 0) {
+		APP_ROOM_ENTERWORD_INACTIVE.child = APP_ROOM_ENTERWORD_CHILD_MESSAGE;
+		bui_room_message_args_t args = {
+			.msg = "No similar words\nwere found.",
+			.font = bui_font_open_sans_extrabold_11,
+		};
+		bui_room_enter(&app_room_ctx, &bui_room_message, &args, sizeof(args));
+		return;
+	}
+	APP_ROOM_ENTERWORD_INACTIVE.child = APP_ROOM_ENTERWORD_CHILD_PICKWORD;
+	os_memcpy(APP_ROOM_ENTERWORD_INACTIVE.suggestions, suggestions, count * sizeof(uint16_t));
+	app_room_pickword_args_t args = {
+		.first = 0,
+		.count = count,
+		.words = APP_ROOM_ENTERWORD_INACTIVE.suggestions,
+	};
+	bui_room_enter(&app_room_ctx, &app_rooms_pickword, &args, sizeof(args));
 }
@@ -0,0 +1,120 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "app_rooms.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "os.h"
+#include "os_io_seproxyhal.h"
+
+#include "bui.h"
+#include "bui_font.h"
+#include "bui_room.h"
+
+#include "app.h"
+#include "app_seedutils.h"
+
+/*
+ * Room Memory Management Strategy:
+ *
+ * This room has nothing allocated in its stack frame. It is entered from the main menu when the fingerprint APDU is
+ * received, and it answers that APDU itself once the user has confirmed or rejected the request.
+ */
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_room_fingerprint_handle_event(bui_room_ctx_t *ctx, const bui_room_event_t *event);
+
+static void app_room_fingerprint_enter(bool up);
+static void app_room_fingerprint_exit(bool up);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+const bui_room_t app_rooms_fingerprint = {
+	.event_handler = app_room_fingerprint_handle_event,
+};
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_room_fingerprint_handle_event(bui_room_ctx_t *ctx, const bui_room_event_t *event) {
+	switch (event->id) {
+	case BUI_ROOM_EVENT_ENTER: {
+		bool up = BUI_ROOM_EVENT_DATA_ENTER(event)->up;
+		app_room_fingerprint_enter(up);
+	} break;
+	case BUI_ROOM_EVENT_EXIT: {
+		bool up = BUI_ROOM_EVENT_DATA_EXIT(event)->up;
+		app_room_fingerprint_exit(up);
+	} break;
+	// Other events are acknowledged
+	default:
+		break;
+	}
+}
+
+static void app_room_fingerprint_enter(bool up) {
+	if (up) {
+		bui_room_confirm_args_t args = {
+			.msg = "Export the seed's\nfingerprint?",
+			.font = bui_font_open_sans_extrabold_11,
+		};
+		app_disp_invalidate();
+		bui_room_enter(&app_room_ctx, &bui_room_confirm, &args, sizeof(args));
+		return;
+	}
+	bui_room_confirm_ret_t confirm_ret;
+	bui_room_pop(&app_room_ctx, &confirm_ret, sizeof(confirm_ret));
+	unsigned short tx = 0;
+	unsigned short sw;
+	if (confirm_ret.confirmed) {
+		app_seedutils_device_fingerprint(G_io_apdu_buffer);
+		tx = 20;
+		sw = 0x9000;
+	} else {
+		sw = 0x6985; // Conditions of use not satisfied (rejected by the user)
+	}
+	G_io_apdu_buffer[tx++] = sw >> 8;
+	G_io_apdu_buffer[tx++] = sw;
+	io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, tx);
+	bui_room_exit(&app_room_ctx);
+}
+
+static void app_room_fingerprint_exit(bool up) {
+	if (!up)
+		bui_room_dealloc_frame(&app_room_ctx);
+}
@@ -57,6 +57,9 @@ typedef struct app_room_main_inactive_t {
 //                                                                            //
 //----------------------------------------------------------------------------//
 
+// Whether this room is the current room (it is active, rather than waiting for a room it entered to exit)
+static bool app_room_main_active;
+
 static const uint8_t app_room_main_bmp_icon_bb[] = {
 	0x00, 0x00, 0x0F, 0xF0, 0x3E, 0x7C, 0x3E, 0x7C,
 	0x78, 0x7E, 0x72, 0x7E, 0x64, 0x7E, 0x68, 0x1E,
@@ -103,6 +106,16 @@ const bui_room_t app_rooms_main = {
 	.event_handler = app_room_main_handle_event,
 };
 
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+bool app_room_main_current() {
+	return app_room_main_active;
+}
+
 //----------------------------------------------------------------------------//
 //                                                                            //
 //                       Internal Function Definitions                        //
@@ -150,13 +163,15 @@ static void app_room_main_enter(bool up) {
 	bui_room_alloc(&app_room_ctx, sizeof(app_room_main_active_t));
 	APP_ROOM_MAIN_ACTIVE.menu.elem_size_callback = app_room_main_elem_size;
 	APP_ROOM_MAIN_ACTIVE.menu.elem_draw_callback = app_room_main_elem_draw;
-	bui_menu_init(&APP_ROOM_MAIN_ACTIVE.menu, 4, inactive.focus, true);
+	bui_menu_init(&APP_ROOM_MAIN_ACTIVE.menu, 5, inactive.focus, true);
+	app_room_main_active = true;
 	app_disp_invalidate();
 }
 
 static void app_room_main_exit(bool up) {
 	if (!up)
 		os_sched_exit(0); // Go back to the dashboard
+	app_room_main_active = false;
 	app_room_main_inactive_t inactive;
 	inactive.focus = bui_menu_get_focused(&APP_ROOM_MAIN_ACTIVE.menu);
 	bui_room_dealloc(&app_room_ctx, sizeof(app_room_main_active_t));
@@ -177,12 +192,16 @@ static void app_room_main_button_clicked(bui_button_id_t button) {
 	case BUI_BUTTON_NANOS_BOTH:
 		switch (bui_menu_get_focused(&APP_ROOM_MAIN_ACTIVE.menu)) {
 		case 1:
-			bui_room_enter(&app_room_ctx, &app_rooms_verifybackup, NULL, 0);
-			break;
-		case 2:
+		case 2: {
+			app_room_verifybackup_args_t args = {
+				.compare_backups = bui_menu_get_focused(&APP_ROOM_MAIN_ACTIVE.menu) == 2,
+			};
+			bui_room_enter(&app_room_ctx, &app_rooms_verifybackup, &args, sizeof(args));
+		} break;
+		case 3:
 			bui_room_enter(&app_room_ctx, &app_rooms_about, NULL, 0);
 			break;
-		case 3:
+		case 4:
 			bui_room_exit(&app_room_ctx);
 			break;
 		}
@@ -203,7 +222,8 @@ static uint8_t app_room_main_elem_size(const bui_menu_menu_t *menu, uint8_t i) {
 		case 0: return 20;
 		case 1: return 15;
 		case 2: return 15;
-		case 3: return 18;
+		case 3: return 15;
+		case 4: return 18;
 	}
 	// Impossible case
 	return 0;
@@ -219,9 +239,12 @@ static void app_room_main_elem_draw(const bui_menu_menu_t *menu, uint8_t i, bui_
 		bui_font_draw_string(&app_bui_ctx, "Verify Backup", 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
 		break;
 	case 2:
-		bui_font_draw_string(&app_bui_ctx, "About", 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+		bui_font_draw_string(&app_bui_ctx, "Compare Backups", 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
 		break;
 	case 3:
+		bui_font_draw_string(&app_bui_ctx, "About", 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+		break;
+	case 4:
 		bui_ctx_draw_bitmap_full(&app_bui_ctx, BUI_BMP_BADGE_DASHBOARD, 29, y + 2);
 		bui_font_draw_string(&app_bui_ctx, "Quit app", 52, y + 9, BUI_DIR_LEFT, bui_font_open_sans_extrabold_11);
 		break;
@@ -0,0 +1,209 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "app_rooms.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "os.h"
+
+#include "bui.h"
+#include "bui_font.h"
+#include "bui_menu.h"
+#include "bui_room.h"
+
+#include "app.h"
+#include "app_seedutils.h"
+
+/*
+ * Room Memory Management Strategy:
+ *
+ * This room always has app_room_pickword_args_t allocated at the bottom of its stack frame, followed by
+ * app_room_pickword_active_t. On exit, the entire frame is replaced by app_room_pickword_ret_t.
+ */
+
+#define APP_ROOM_PICKWORD_ARGS (*((app_room_pickword_args_t*) app_room_ctx.frame_ptr))
+#define APP_ROOM_PICKWORD_ACTIVE (*((app_room_pickword_active_t*) (&APP_ROOM_PICKWORD_ARGS + 1)))
+#define APP_ROOM_PICKWORD_RET (*((app_room_pickword_ret_t*) app_room_ctx.frame_ptr))
+
+#define APP_ROOM_PICKWORD_MENU_SIZE (APP_ROOM_PICKWORD_ARGS.count + 2)
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                  Internal Type Declarations & Definitions                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+typedef struct app_room_pickword_active_t {
+	bui_menu_menu_t menu;
+} app_room_pickword_active_t;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_room_pickword_handle_event(bui_room_ctx_t *ctx, const bui_room_event_t *event);
+
+static void app_room_pickword_enter(bool up);
+static void app_room_pickword_exit(bool up);
+static void app_room_pickword_draw();
+static void app_room_pickword_time_elapsed(uint32_t elapsed);
+static void app_room_pickword_button_clicked(bui_button_id_t button);
+
+static uint8_t app_room_pickword_elem_size(const bui_menu_menu_t *menu, uint8_t i);
+static void app_room_pickword_elem_draw(const bui_menu_menu_t *menu, uint8_t i, bui_ctx_t *bui_ctx, int16_t y);
+
+static uint16_t app_room_pickword_word_index(uint8_t i);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+const bui_room_t app_rooms_pickword = {
+	.event_handler = app_room_pickword_handle_event,
+};
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_room_pickword_handle_event(bui_room_ctx_t *ctx, const bui_room_event_t *event) {
+	switch (event->id) {
+	case BUI_ROOM_EVENT_ENTER: {
+		bool up = BUI_ROOM_EVENT_DATA_ENTER(event)->up;
+		app_room_pickword_enter(up);
+	} break;
+	case BUI_ROOM_EVENT_EXIT: {
+		bool up = BUI_ROOM_EVENT_DATA_EXIT(event)->up;
+		app_room_pickword_exit(up);
+	} break;
+	case BUI_ROOM_EVENT_DRAW: {
+		app_room_pickword_draw();
+	} break;
+	case BUI_ROOM_EVENT_FORWARD: {
+		const bui_event_t *bui_event = BUI_ROOM_EVENT_DATA_FORWARD(event);
+		switch (bui_event->id) {
+		case BUI_EVENT_TIME_ELAPSED: {
+			uint32_t elapsed = BUI_EVENT_DATA_TIME_ELAPSED(bui_event)->elapsed;
+			app_room_pickword_time_elapsed(elapsed);
+		} break;
+		case BUI_EVENT_BUTTON_CLICKED: {
+			bui_button_id_t button = BUI_EVENT_DATA_BUTTON_CLICKED(bui_event)->button;
+			app_room_pickword_button_clicked(button);
+		} break;
+		// Other events are acknowledged
+		default:
+			break;
+		}
+	} break;
+	}
+}
+
+static void app_room_pickword_enter(bool up) {
+	bui_room_alloc(&app_room_ctx, sizeof(app_room_pickword_active_t));
+	APP_ROOM_PICKWORD_ACTIVE.menu.elem_size_callback = app_room_pickword_elem_size;
+	APP_ROOM_PICKWORD_ACTIVE.menu.elem_draw_callback = app_room_pickword_elem_draw;
+	bui_menu_init(&APP_ROOM_PICKWORD_ACTIVE.menu, APP_ROOM_PICKWORD_MENU_SIZE, 1, true);
+	app_disp_invalidate();
+}
+
+static void app_room_pickword_exit(bool up) {
+	uint8_t focused = bui_menu_get_focused(&APP_ROOM_PICKWORD_ACTIVE.menu);
+	uint16_t word_index = APP_SEEDUTILS_WORD_COUNT;
+	if (focused != APP_ROOM_PICKWORD_MENU_SIZE - 1)
+		word_index = app_room_pickword_word_index(focused - 1);
+	bui_room_dealloc_frame(&app_room_ctx);
+	bui_room_alloc(&app_room_ctx, sizeof(app_room_pickword_ret_t));
+	APP_ROOM_PICKWORD_RET.word_index = word_index;
+}
+
+static void app_room_pickword_draw() {
+	bui_menu_draw(&APP_ROOM_PICKWORD_ACTIVE.menu, &app_bui_ctx);
+}
+
+static void app_room_pickword_time_elapsed(uint32_t elapsed) {
+	if (bui_menu_animate(&APP_ROOM_PICKWORD_ACTIVE.menu, elapsed))
+		app_disp_invalidate();
+}
+
+static void app_room_pickword_button_clicked(bui_button_id_t button) {
+	switch (button) {
+	case BUI_BUTTON_NANOS_BOTH:
+		// The prompt can't be selected; a word or "Start over" can
+		if (bui_menu_get_focused(&APP_ROOM_PICKWORD_ACTIVE.menu) != 0)
+			bui_room_exit(&app_room_ctx);
+		break;
+	case BUI_BUTTON_NANOS_LEFT:
+		bui_menu_scroll(&APP_ROOM_PICKWORD_ACTIVE.menu, true);
+		app_disp_invalidate();
+		break;
+	case BUI_BUTTON_NANOS_RIGHT:
+		bui_menu_scroll(&APP_ROOM_PICKWORD_ACTIVE.menu, false);
+		app_disp_invalidate();
+		break;
+	}
+}
+
+static uint8_t app_room_pickword_elem_size(const bui_menu_menu_t *menu, uint8_t i) {
+	return 15;
+}
+
+static void app_room_pickword_elem_draw(const bui_menu_menu_t *menu, uint8_t i, bui_ctx_t *bui_ctx, int16_t y) {
+	bool suggestions = APP_ROOM_PICKWORD_ARGS.words != NULL;
+	if (i == 0) {
+		const char *text = suggestions ? "Did you mean:" : "Choose the word:";
+		bui_font_draw_string(&app_bui_ctx, text, 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+	} else if (i == APP_ROOM_PICKWORD_MENU_SIZE - 1) {
+		const char *text = suggestions ? "None of these" : "Start over";
+		bui_font_draw_string(&app_bui_ctx, text, 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+	} else {
+		char text[APP_SEEDUTILS_WORD_LEN_MAX + 1];
+		uint8_t word_len;
+		const char *word = app_seedutils_bip39_word(app_room_pickword_word_index(i - 1), &word_len);
+		os_memcpy(text, word, word_len);
+		text[word_len] = '\0';
+		bui_font_draw_string(&app_bui_ctx, text, 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+	}
+}
+
+/*
+ * Get the index in the wordlist of one of the words to choose from.
+ *
+ * Args:
+ *     i: the position of the word in the list of words to choose from; must be less than the number of words
+ * Returns:
+ *     the index of the word in the wordlist
+ */
+static uint16_t app_room_pickword_word_index(uint8_t i) {
+	if (APP_ROOM_PICKWORD_ARGS.words != NULL)
+		return APP_ROOM_PICKWORD_ARGS.words[i];
+	return APP_ROOM_PICKWORD_ARGS.first + i;
+}
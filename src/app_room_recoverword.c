@@ -0,0 +1,265 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "app_rooms.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "os.h"
+
+#include "bui.h"
+#include "bui_font.h"
+#include "bui_menu.h"
+#include "bui_room.h"
+
+#include "app.h"
+#include "app_seedutils.h"
+
+/*
+ * Room Memory Management Strategy:
+ *
+ * This room always has app_room_recoverword_args_t allocated at the bottom of its stack frame, followed by
+ * app_room_recoverword_active_t, followed by the index of every candidate word found so far. On exit, the entire frame
+ * is replaced by app_room_recoverword_ret_t.
+ */
+
+#define APP_ROOM_RECOVERWORD_ARGS (*((app_room_recoverword_args_t*) app_room_ctx.frame_ptr))
+#define APP_ROOM_RECOVERWORD_ACTIVE (*((app_room_recoverword_active_t*) (&APP_ROOM_RECOVERWORD_ARGS + 1)))
+#define APP_ROOM_RECOVERWORD_CANDIDATES ((uint16_t*) (&APP_ROOM_RECOVERWORD_ACTIVE + 1))
+#define APP_ROOM_RECOVERWORD_RET (*((app_room_recoverword_ret_t*) app_room_ctx.frame_ptr))
+
+#define APP_ROOM_RECOVERWORD_MENU_SIZE (APP_ROOM_RECOVERWORD_ACTIVE.count + 2)
+
+// The greatest number of candidates listed; a 12 word seed has about 128 candidates for any position
+#define APP_ROOM_RECOVERWORD_CANDIDATES_MAX 192
+// The number of words tested as candidates per tick, after which the progress is redrawn; a tick may test more words,
+// up to the next candidate found
+#define APP_ROOM_RECOVERWORD_SEARCH_STEP 128
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                  Internal Type Declarations & Definitions                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+typedef struct app_room_recoverword_active_t {
+	bui_menu_menu_t menu;
+	// The next word to test as a candidate, or APP_SEEDUTILS_WORD_COUNT if the search for candidates is done
+	uint16_t next;
+	// The number of candidates found
+	uint8_t count;
+	// true if there are more candidates than APP_ROOM_RECOVERWORD_CANDIDATES_MAX, of which only the first are listed
+	bool capped;
+} app_room_recoverword_active_t;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_room_recoverword_handle_event(bui_room_ctx_t *ctx, const bui_room_event_t *event);
+
+static void app_room_recoverword_enter(bool up);
+static void app_room_recoverword_exit(bool up);
+static void app_room_recoverword_draw();
+static void app_room_recoverword_time_elapsed(uint32_t elapsed);
+static void app_room_recoverword_button_clicked(bui_button_id_t button);
+
+static void app_room_recoverword_search();
+
+static uint8_t app_room_recoverword_elem_size(const bui_menu_menu_t *menu, uint8_t i);
+static void app_room_recoverword_elem_draw(const bui_menu_menu_t *menu, uint8_t i, bui_ctx_t *bui_ctx, int16_t y);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+const bui_room_t app_rooms_recoverword = {
+	.event_handler = app_room_recoverword_handle_event,
+};
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_room_recoverword_handle_event(bui_room_ctx_t *ctx, const bui_room_event_t *event) {
+	switch (event->id) {
+	case BUI_ROOM_EVENT_ENTER: {
+		bool up = BUI_ROOM_EVENT_DATA_ENTER(event)->up;
+		app_room_recoverword_enter(up);
+	} break;
+	case BUI_ROOM_EVENT_EXIT: {
+		bool up = BUI_ROOM_EVENT_DATA_EXIT(event)->up;
+		app_room_recoverword_exit(up);
+	} break;
+	case BUI_ROOM_EVENT_DRAW: {
+		app_room_recoverword_draw();
+	} break;
+	case BUI_ROOM_EVENT_FORWARD: {
+		const bui_event_t *bui_event = BUI_ROOM_EVENT_DATA_FORWARD(event);
+		switch (bui_event->id) {
+		case BUI_EVENT_TIME_ELAPSED: {
+			uint32_t elapsed = BUI_EVENT_DATA_TIME_ELAPSED(bui_event)->elapsed;
+			app_room_recoverword_time_elapsed(elapsed);
+		} break;
+		case BUI_EVENT_BUTTON_CLICKED: {
+			bui_button_id_t button = BUI_EVENT_DATA_BUTTON_CLICKED(bui_event)->button;
+			app_room_recoverword_button_clicked(button);
+		} break;
+		// Other events are acknowledged
+		default:
+			break;
+		}
+	} break;
+	}
+}
+
+static void app_room_recoverword_enter(bool up) {
+	bui_room_alloc(&app_room_ctx, sizeof(app_room_recoverword_active_t));
+	APP_ROOM_RECOVERWORD_ACTIVE.next = 0;
+	APP_ROOM_RECOVERWORD_ACTIVE.count = 0;
+	APP_ROOM_RECOVERWORD_ACTIVE.capped = false;
+	app_disp_invalidate();
+}
+
+static void app_room_recoverword_exit(bool up) {
+	uint8_t focused = bui_menu_get_focused(&APP_ROOM_RECOVERWORD_ACTIVE.menu);
+	uint16_t word_index = APP_SEEDUTILS_WORD_COUNT;
+	if (focused != APP_ROOM_RECOVERWORD_MENU_SIZE - 1)
+		word_index = APP_ROOM_RECOVERWORD_CANDIDATES[focused - 1];
+	bui_room_dealloc_frame(&app_room_ctx);
+	bui_room_alloc(&app_room_ctx, sizeof(app_room_recoverword_ret_t));
+	APP_ROOM_RECOVERWORD_RET.word_index = word_index;
+}
+
+static void app_room_recoverword_draw() {
+	if (APP_ROOM_RECOVERWORD_ACTIVE.next == APP_SEEDUTILS_WORD_COUNT) {
+		bui_menu_draw(&APP_ROOM_RECOVERWORD_ACTIVE.menu, &app_bui_ctx);
+	} else {
+		char text[20];
+		uint8_t percent = APP_ROOM_RECOVERWORD_ACTIVE.next * 100 / APP_SEEDUTILS_WORD_COUNT;
+		snprintf(text, sizeof(text), "%u%%, %u found", percent, APP_ROOM_RECOVERWORD_ACTIVE.count);
+		bui_font_draw_string(&app_bui_ctx, "Searching...", 64, 4, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+		bui_font_draw_string(&app_bui_ctx, text, 64, 17, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+	}
+}
+
+static void app_room_recoverword_time_elapsed(uint32_t elapsed) {
+	if (APP_ROOM_RECOVERWORD_ACTIVE.next != APP_SEEDUTILS_WORD_COUNT) {
+		app_room_recoverword_search();
+		return;
+	}
+	if (bui_menu_animate(&APP_ROOM_RECOVERWORD_ACTIVE.menu, elapsed))
+		app_disp_invalidate();
+}
+
+static void app_room_recoverword_button_clicked(bui_button_id_t button) {
+	if (APP_ROOM_RECOVERWORD_ACTIVE.next != APP_SEEDUTILS_WORD_COUNT)
+		return;
+	switch (button) {
+	case BUI_BUTTON_NANOS_BOTH:
+		// The prompt can't be selected; a word or "Cancel" can
+		if (bui_menu_get_focused(&APP_ROOM_RECOVERWORD_ACTIVE.menu) != 0)
+			bui_room_exit(&app_room_ctx);
+		break;
+	case BUI_BUTTON_NANOS_LEFT:
+		bui_menu_scroll(&APP_ROOM_RECOVERWORD_ACTIVE.menu, true);
+		app_disp_invalidate();
+		break;
+	case BUI_BUTTON_NANOS_RIGHT:
+		bui_menu_scroll(&APP_ROOM_RECOVERWORD_ACTIVE.menu, false);
+		app_disp_invalidate();
+		break;
+	}
+}
+
+/*
+ * Continue the search for candidates by testing at least APP_ROOM_RECOVERWORD_SEARCH_STEP more words (or the rest of
+ * the wordlist), so that the search is spread over several ticks and its progress can be shown. Once the search is
+ * done, the list of candidates is shown.
+ */
+static void app_room_recoverword_search() {
+	const uint16_t *indices = APP_ROOM_RECOVERWORD_ARGS.indices;
+	uint8_t word_count = APP_ROOM_RECOVERWORD_ARGS.word_count;
+	uint8_t slot = APP_ROOM_RECOVERWORD_ARGS.slot;
+	uint16_t next = APP_ROOM_RECOVERWORD_ACTIVE.next;
+	uint16_t limit = next + APP_ROOM_RECOVERWORD_SEARCH_STEP;
+	while (next < limit && next != APP_SEEDUTILS_WORD_COUNT) {
+		uint16_t candidate = app_seedutils_checksum_next(indices, word_count, slot, next);
+		if (candidate == APP_SEEDUTILS_WORD_COUNT) {
+			next = APP_SEEDUTILS_WORD_COUNT;
+		} else if (APP_ROOM_RECOVERWORD_ACTIVE.count == APP_ROOM_RECOVERWORD_CANDIDATES_MAX) {
+			// There is at least one candidate more than can be listed
+			APP_ROOM_RECOVERWORD_ACTIVE.capped = true;
+			next = APP_SEEDUTILS_WORD_COUNT;
+		} else {
+			*((uint16_t*) bui_room_alloc(&app_room_ctx, sizeof(uint16_t))) = candidate;
+			APP_ROOM_RECOVERWORD_ACTIVE.count++;
+			next = candidate + 1;
+		}
+	}
+	APP_ROOM_RECOVERWORD_ACTIVE.next = next;
+	if (next == APP_SEEDUTILS_WORD_COUNT) {
+		APP_ROOM_RECOVERWORD_ACTIVE.menu.elem_size_callback = app_room_recoverword_elem_size;
+		APP_ROOM_RECOVERWORD_ACTIVE.menu.elem_draw_callback = app_room_recoverword_elem_draw;
+		bui_menu_init(&APP_ROOM_RECOVERWORD_ACTIVE.menu, APP_ROOM_RECOVERWORD_MENU_SIZE, 1, true);
+	}
+	app_disp_invalidate();
+}
+
+static uint8_t app_room_recoverword_elem_size(const bui_menu_menu_t *menu, uint8_t i) {
+	if (i == 0)
+		return 27;
+	else
+		return 15;
+}
+
+static void app_room_recoverword_elem_draw(const bui_menu_menu_t *menu, uint8_t i, bui_ctx_t *bui_ctx, int16_t y) {
+	if (i == 0) {
+		char text[16];
+		snprintf(text, sizeof(text), "Word #%u may", APP_ROOM_RECOVERWORD_ARGS.slot + 1);
+		bui_font_draw_string(&app_bui_ctx, text, 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+		if (APP_ROOM_RECOVERWORD_ACTIVE.capped)
+			snprintf(text, sizeof(text), "be one of %u+:", APP_ROOM_RECOVERWORD_ACTIVE.count);
+		else
+			snprintf(text, sizeof(text), "be one of:");
+		bui_font_draw_string(&app_bui_ctx, text, 64, y + 14, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+	} else if (i == APP_ROOM_RECOVERWORD_MENU_SIZE - 1) {
+		bui_font_draw_string(&app_bui_ctx, "Cancel", 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+	} else {
+		char text[APP_SEEDUTILS_WORD_LEN_MAX + 1];
+		uint8_t word_len;
+		const char *word = app_seedutils_bip39_word(APP_ROOM_RECOVERWORD_CANDIDATES[i - 1], &word_len);
+		os_memcpy(text, word, word_len);
+		text[word_len] = '\0';
+		bui_font_draw_string(&app_bui_ctx, text, 64, y + 2, BUI_DIR_TOP, bui_font_open_sans_extrabold_11);
+	}
+}
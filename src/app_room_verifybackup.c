@@ -26,18 +26,28 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
+#include "os.h"
+#include "cx.h"
+
 #include "bui.h"
 #include "bui_room.h"
 
 #include "app.h"
+#include "app_seedutils.h"
 
 /*
  * Room Memory Management Strategy:
  *
  * This room always has app_room_verifybackup_data_t allocated at the bottom of its stack frame, and then when the
- * app_rooms_enterseed room is called, the mnemonic is pushed onto the stack as well.
+ * app_rooms_enterseed room is called, the mnemonic is pushed onto the stack as well. The word indices of the mnemonic
+ * are kept in app_room_verifybackup_data_t only for as long as the user may still choose to correct the words and
+ * verify the seed again, and are cleared as soon as they are no longer needed; only a hash of them is kept with the
+ * last verdict. When two backups are compared with each other, the word indices are those of the first backup, and a
+ * buffer for the message describing the result is allocated on top of the stack frame at the end. The whole stack frame
+ * is cleared on exit.
  */
 
 #define APP_ROOM_VERIFYBACKUP_DATA (*((app_room_verifybackup_data_t*) app_room_ctx.frame_ptr))
@@ -56,11 +66,32 @@ typedef uint8_t app_room_verifybackup_state_t;
 #define APP_ROOM_VERIFYBACKUP_STATE_ENTERSEED    ((app_room_verifybackup_state_t) 1)
 #define APP_ROOM_VERIFYBACKUP_STATE_COMPARESEED  ((app_room_verifybackup_state_t) 2)
 #define APP_ROOM_VERIFYBACKUP_STATE_RESULTS      ((app_room_verifybackup_state_t) 3)
-#define APP_ROOM_VERIFYBACKUP_STATE_DONE         ((app_room_verifybackup_state_t) 4)
+#define APP_ROOM_VERIFYBACKUP_STATE_RETRY        ((app_room_verifybackup_state_t) 4)
+#define APP_ROOM_VERIFYBACKUP_STATE_FIX          ((app_room_verifybackup_state_t) 5)
+#define APP_ROOM_VERIFYBACKUP_STATE_ENTERSECOND  ((app_room_verifybackup_state_t) 6)
+#define APP_ROOM_VERIFYBACKUP_STATE_DIFF         ((app_room_verifybackup_state_t) 7)
+#define APP_ROOM_VERIFYBACKUP_STATE_DONE         ((app_room_verifybackup_state_t) 8)
+
+// The size of the buffer for the message describing the result of comparing two backups (three lines and a
+// null-terminator)
+#define APP_ROOM_VERIFYBACKUP_DIFF_MSG_SIZE 72
+
+// Used for app_room_verifybackup_data_t.verdict if the seed with the stored word indices has not been compared yet
+#define APP_ROOM_VERIFYBACKUP_VERDICT_NONE ((app_room_compareseed_ret_t) 0xFF)
 
 typedef struct __attribute__((aligned(4))) {
 	// State of the room
 	app_room_verifybackup_state_t state;
+	// true if two backups are compared with each other, false if a backup is compared with the seed on the device
+	bool compare_backups;
+	// The number of words in the seed; 12, 18, or 24
+	uint8_t seed_length;
+	// The result of comparing the seed whose word indices hash to verdict_hash, or APP_ROOM_VERIFYBACKUP_VERDICT_NONE
+	app_room_compareseed_ret_t verdict;
+	// The SHA-256 hash of the word indices of the seed for which verdict was found
+	uint8_t verdict_hash[32];
+	// The word indices of the last seed entered, while they may be needed to correct it (all 0 otherwise)
+	uint16_t indices[APP_SEEDUTILS_SEED_LENGTH_MAX];
 } app_room_verifybackup_data_t;
 
 //----------------------------------------------------------------------------//
@@ -75,6 +106,8 @@ static void app_room_verifybackup_enter(bool up);
 static void app_room_verifybackup_exit(bool up);
 
 static void app_room_verifybackup_advance();
+static void app_room_verifybackup_hash_indices(const uint16_t *indices, uint8_t *hash_dest);
+static void app_room_verifybackup_diff_msg(char *msg, const uint16_t *indices);
 
 //----------------------------------------------------------------------------//
 //                                                                            //
@@ -110,15 +143,22 @@ static void app_room_verifybackup_handle_event(bui_room_ctx_t *ctx, const bui_ro
 
 static void app_room_verifybackup_enter(bool up) {
 	if (up) {
+		app_room_verifybackup_args_t args;
+		bui_room_pop(&app_room_ctx, &args, sizeof(args));
 		bui_room_alloc(&app_room_ctx, sizeof(app_room_verifybackup_data_t));
+		os_memset(&APP_ROOM_VERIFYBACKUP_DATA, 0, sizeof(app_room_verifybackup_data_t));
 		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_CHOOSELENGTH;
+		APP_ROOM_VERIFYBACKUP_DATA.compare_backups = args.compare_backups;
+		APP_ROOM_VERIFYBACKUP_DATA.verdict = APP_ROOM_VERIFYBACKUP_VERDICT_NONE;
 	}
 	app_room_verifybackup_advance();
 }
 
 static void app_room_verifybackup_exit(bool up) {
-	if (!up)
+	if (!up) {
+		os_memset(&APP_ROOM_VERIFYBACKUP_DATA, 0, sizeof(app_room_verifybackup_data_t));
 		bui_room_dealloc_frame(&app_room_ctx);
+	}
 }
 
 static void app_room_verifybackup_advance() {
@@ -128,22 +168,43 @@ static void app_room_verifybackup_advance() {
 		bui_room_enter(&app_room_ctx, &app_rooms_chooselength, NULL, 0);
 	} break;
 	case APP_ROOM_VERIFYBACKUP_STATE_ENTERSEED: {
-		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_COMPARESEED;
-		uint8_t seed_length = APP_ROOM_VERIFYBACKUP_CHOOSELENGTH_RET.seed_length;
+		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_DATA.compare_backups ?
+				APP_ROOM_VERIFYBACKUP_STATE_ENTERSECOND : APP_ROOM_VERIFYBACKUP_STATE_COMPARESEED;
+		APP_ROOM_VERIFYBACKUP_DATA.seed_length = APP_ROOM_VERIFYBACKUP_CHOOSELENGTH_RET.seed_length;
 		bui_room_dealloc(&app_room_ctx, sizeof(app_room_chooselength_ret_t));
-		app_room_enterseed_args_t args = { .seed_length = seed_length };
+		app_room_enterseed_args_t args = { .seed_length = APP_ROOM_VERIFYBACKUP_DATA.seed_length, .indices = NULL };
 		bui_room_enter(&app_room_ctx, &app_rooms_enterseed, &args, sizeof(args));
 	} break;
 	case APP_ROOM_VERIFYBACKUP_STATE_COMPARESEED: {
 		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_RESULTS;
 		uint8_t mnemonic_len = strlen(APP_ROOM_VERIFYBACKUP_ENTERSEED_RET);
+		uint16_t *indices = APP_ROOM_VERIFYBACKUP_DATA.indices;
+		app_seedutils_bip39_indices(APP_ROOM_VERIFYBACKUP_ENTERSEED_RET, mnemonic_len, indices);
+		uint8_t hash[32];
+		app_room_verifybackup_hash_indices(indices, hash);
+		if (APP_ROOM_VERIFYBACKUP_DATA.verdict != APP_ROOM_VERIFYBACKUP_VERDICT_NONE &&
+				os_memcmp(hash, APP_ROOM_VERIFYBACKUP_DATA.verdict_hash, sizeof(hash)) == 0) {
+			// The seed was resubmitted unchanged, so the last verdict still applies
+			os_memset(APP_ROOM_VERIFYBACKUP_ENTERSEED_RET, 0, mnemonic_len + 1);
+			bui_room_dealloc(&app_room_ctx, mnemonic_len + 1);
+			bui_room_push(&app_room_ctx, &APP_ROOM_VERIFYBACKUP_DATA.verdict, sizeof(app_room_compareseed_ret_t));
+			app_room_verifybackup_advance();
+			return;
+		}
+		os_memcpy(APP_ROOM_VERIFYBACKUP_DATA.verdict_hash, hash, sizeof(hash));
+		APP_ROOM_VERIFYBACKUP_DATA.verdict = APP_ROOM_VERIFYBACKUP_VERDICT_NONE;
 		app_disp_invalidate();
 		bui_room_enter(&app_room_ctx, &app_rooms_compareseed, NULL, mnemonic_len + 1);
 	} break;
 	case APP_ROOM_VERIFYBACKUP_STATE_RESULTS: {
-		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_DONE;
 		app_room_compareseed_ret_t compareseed_ret;
 		bui_room_pop(&app_room_ctx, &compareseed_ret, sizeof(compareseed_ret));
+		APP_ROOM_VERIFYBACKUP_DATA.verdict = compareseed_ret;
+		APP_ROOM_VERIFYBACKUP_DATA.state = compareseed_ret == APP_ROOM_COMPARESEED_RET_EQUAL ?
+				APP_ROOM_VERIFYBACKUP_STATE_DONE : APP_ROOM_VERIFYBACKUP_STATE_RETRY;
+		// The words will not be corrected if the seed is the same as the seed on the device
+		if (compareseed_ret == APP_ROOM_COMPARESEED_RET_EQUAL)
+			os_memset(APP_ROOM_VERIFYBACKUP_DATA.indices, 0, sizeof(APP_ROOM_VERIFYBACKUP_DATA.indices));
 		const char *msg;
 		switch (compareseed_ret) {
 		case APP_ROOM_COMPARESEED_RET_EQUAL:
@@ -160,8 +221,107 @@ static void app_room_verifybackup_advance() {
 		app_disp_invalidate();
 		bui_room_enter(&app_room_ctx, &bui_room_message, &message_args, sizeof(message_args));
 	} break;
+	case APP_ROOM_VERIFYBACKUP_STATE_RETRY: {
+		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_FIX;
+		bui_room_confirm_args_t args = {
+			.msg = "Fix the words\nand try again?",
+			.font = bui_font_open_sans_extrabold_11,
+		};
+		app_disp_invalidate();
+		bui_room_enter(&app_room_ctx, &bui_room_confirm, &args, sizeof(args));
+	} break;
+	case APP_ROOM_VERIFYBACKUP_STATE_FIX: {
+		bui_room_confirm_ret_t confirm_ret;
+		bui_room_pop(&app_room_ctx, &confirm_ret, sizeof(confirm_ret));
+		if (!confirm_ret.confirmed) {
+			bui_room_exit(&app_room_ctx);
+			return;
+		}
+		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_COMPARESEED;
+		app_room_enterseed_args_t args = {
+			.seed_length = APP_ROOM_VERIFYBACKUP_DATA.seed_length,
+			.indices = APP_ROOM_VERIFYBACKUP_DATA.indices,
+		};
+		app_disp_invalidate();
+		bui_room_enter(&app_room_ctx, &app_rooms_enterseed, &args, sizeof(args));
+	} break;
+	case APP_ROOM_VERIFYBACKUP_STATE_ENTERSECOND: {
+		// Keep only the word indices of the first backup, then enter the second backup
+		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_DIFF;
+		uint8_t mnemonic_len = strlen(APP_ROOM_VERIFYBACKUP_ENTERSEED_RET);
+		app_seedutils_bip39_indices(APP_ROOM_VERIFYBACKUP_ENTERSEED_RET, mnemonic_len, APP_ROOM_VERIFYBACKUP_DATA.indices);
+		bui_room_dealloc(&app_room_ctx, mnemonic_len + 1);
+		app_room_enterseed_args_t args = { .seed_length = APP_ROOM_VERIFYBACKUP_DATA.seed_length, .indices = NULL };
+		app_disp_invalidate();
+		bui_room_enter(&app_room_ctx, &app_rooms_enterseed, &args, sizeof(args));
+	} break;
+	case APP_ROOM_VERIFYBACKUP_STATE_DIFF: {
+		// Compare the second backup to the first word by word; neither is compared to the seed on the device, so no key
+		// stretching is needed
+		APP_ROOM_VERIFYBACKUP_DATA.state = APP_ROOM_VERIFYBACKUP_STATE_DONE;
+		uint8_t mnemonic_len = strlen(APP_ROOM_VERIFYBACKUP_ENTERSEED_RET);
+		uint16_t indices[APP_SEEDUTILS_SEED_LENGTH_MAX];
+		app_seedutils_bip39_indices(APP_ROOM_VERIFYBACKUP_ENTERSEED_RET, mnemonic_len, indices);
+		bui_room_dealloc(&app_room_ctx, mnemonic_len + 1);
+		char *msg = bui_room_alloc(&app_room_ctx, APP_ROOM_VERIFYBACKUP_DIFF_MSG_SIZE);
+		app_room_verifybackup_diff_msg(msg, indices);
+		os_memset(indices, 0, sizeof(indices));
+		os_memset(APP_ROOM_VERIFYBACKUP_DATA.indices, 0, sizeof(APP_ROOM_VERIFYBACKUP_DATA.indices));
+		bui_room_message_args_t message_args = { .msg = msg, .font = bui_font_lucida_console_8 };
+		app_disp_invalidate();
+		bui_room_enter(&app_room_ctx, &bui_room_message, &message_args, sizeof(message_args));
+	} break;
 	case APP_ROOM_VERIFYBACKUP_STATE_DONE: {
 		bui_room_exit(&app_room_ctx);
 	} break;
 	}
 }
+
+/*
+ * Hash the provided word indices, to identify the seed for which the last verdict was found without keeping its words.
+ *
+ * Args:
+ *     indices: the word indices; there must be as many as the length of the seed
+ *     hash_dest: the destination in which to store the 32 byte SHA-256 hash
+ */
+static void app_room_verifybackup_hash_indices(const uint16_t *indices, uint8_t *hash_dest) {
+	cx_hash_sha256((const uint8_t*) indices, APP_ROOM_VERIFYBACKUP_DATA.seed_length * sizeof(uint16_t), hash_dest);
+}
+
+/*
+ * Describe the result of comparing a second backup to the first backup (whose word indices are stored in
+ * app_room_verifybackup_data_t): the positions of up to 6 words that differ, and whether each backup has a valid
+ * checksum.
+ *
+ * Args:
+ *     msg: the destination in which to store the message; must be APP_ROOM_VERIFYBACKUP_DIFF_MSG_SIZE bytes
+ *     indices: the word indices of the second backup; there must be as many as the length of the seed
+ */
+static void app_room_verifybackup_diff_msg(char *msg, const uint16_t *indices) {
+	uint8_t seed_length = APP_ROOM_VERIFYBACKUP_DATA.seed_length;
+	const char *checksum1 = app_seedutils_valid_checksum_indices(APP_ROOM_VERIFYBACKUP_DATA.indices, seed_length) ?
+			"OK" : "BAD";
+	const char *checksum2 = app_seedutils_valid_checksum_indices(indices, seed_length) ? "OK" : "BAD";
+	uint8_t differ = 0;
+	char positions[24];
+	uint8_t positions_len = 0;
+	positions[0] = '\0';
+	for (uint8_t i = 0; i < seed_length; i++) {
+		if (indices[i] == APP_ROOM_VERIFYBACKUP_DATA.indices[i])
+			continue;
+		differ++;
+		if (differ <= 6) {
+			snprintf(&positions[positions_len], sizeof(positions) - positions_len, positions_len == 0 ? "%u" : " %u",
+					i + 1);
+			positions_len = strlen(positions);
+		}
+	}
+	if (differ > 6)
+		snprintf(&positions[positions_len], sizeof(positions) - positions_len, " ...");
+	if (differ == 0) {
+		snprintf(msg, APP_ROOM_VERIFYBACKUP_DIFF_MSG_SIZE, "The backups are\nidentical.\nChecksum: %s", checksum1);
+	} else {
+		snprintf(msg, APP_ROOM_VERIFYBACKUP_DIFF_MSG_SIZE, "%u word%s differ%s:\n%s\nChecksums: %s, %s", differ,
+				differ == 1 ? "" : "s", differ == 1 ? "s" : "", positions, checksum1, checksum2);
+	}
+}
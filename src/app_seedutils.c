@@ -40,7 +40,7 @@
 #include "app_seedutils_bip39_data.inc"
 
 // The BIP 32 path node index 6516080'
-static const uint32_t app_seedutils_compare_path = 0x80636D70;
+static const uint32_t app_seedutils_compare_path = APP_SEEDUTILS_COMPARE_PATH;
 
 // Order of the secp256k1 curve, big-endian
 static const uint8_t app_seedutils_secp256k1_order[32] = {
@@ -60,21 +60,97 @@ static const uint8_t app_seedutils_secp256k1_order[32] = {
  * Bitwise-OR an 11-bit sequence onto the specified bit array.
  *
  * Args:
- *     arr: the bit array
- *     i: the index of the 11-bit destination sequence
+ *     arr: the bit array; must be APP_SEEDUTILS_ENT_SIZE bytes
+ *     i: the index of the 11-bit destination sequence; in [0, APP_SEEDUTILS_SEED_LENGTH_MAX - 1]
  *     n: the number to OR onto the destination; must be in [0, 2047]
  */
 void app_seedutils_set_uint11(uint8_t *arr, uint8_t i, uint16_t n);
 
+/*
+ * Read an 11-bit sequence from the specified bit array.
+ *
+ * Args:
+ *     arr: the bit array; must be APP_SEEDUTILS_ENT_SIZE bytes
+ *     i: the index of the 11-bit sequence; in [0, APP_SEEDUTILS_SEED_LENGTH_MAX - 1]
+ * Returns:
+ *     the number stored in the sequence, in [0, 2047]
+ */
+uint16_t app_seedutils_get_uint11(const uint8_t *arr, uint8_t i);
+
+/*
+ * Find the index of the last byte of the 24-bit window holding the specified 11-bit sequence of a bit array of
+ * APP_SEEDUTILS_ENT_SIZE bytes. The window's last byte only holds bits of the sequence when the sequence starts in
+ * the last two bits of its first byte, which is never the case for the final sequence of the array; for that sequence
+ * the returned index is that of the second byte instead, so that the window stays inside the array.
+ *
+ * Args:
+ *     desti: the index of the first bit of the sequence
+ * Returns:
+ *     the index of the last byte of the window
+ */
+static uint8_t app_seedutils_uint11_last(uint16_t desti);
+
+/*
+ * Compute the depth of each position in the choice tree of a binary keyboard layout of the specified size, assuming
+ * that the left half gets the extra position (see app_seedutils_order_letters()).
+ *
+ * Args:
+ *     depths: the destination in which to store the depth of each of the n positions
+ *     n: the number of positions in the subtree
+ *     depth: the depth of the root of the subtree
+ */
+static void app_seedutils_split_depths(uint8_t *depths, uint8_t n, uint8_t depth);
+
+/*
+ * Compare a word in the BIP 39 English wordlist to a prefix, in alphabetical order.
+ *
+ * Args:
+ *     wordi: the index of the word in the wordlist; must be in [0, 2047]
+ *     prefix: the prefix
+ *     prefix_len: the length of prefix
+ * Returns:
+ *     0 if the word begins with prefix, a negative number if the word is ordered before all words beginning with
+ *     prefix, or a positive number if the word is ordered after all words beginning with prefix
+ */
+static int8_t app_seedutils_bip39_prefix_cmp(uint16_t wordi, const char *prefix, uint8_t prefix_len);
+
+/*
+ * Determine if two strings are at most a single edit apart: one character inserted, deleted, or replaced, or two
+ * adjacent characters swapped.
+ *
+ * Args:
+ *     a: the first string
+ *     a_len: the length of a
+ *     b: the second string
+ *     b_len: the length of b
+ * Returns:
+ *     true if a and b are equal or a single edit apart, false otherwise
+ */
+static bool app_seedutils_one_edit(const char *a, uint8_t a_len, const char *b, uint8_t b_len);
+
+/*
+ * Rank a word of the BIP 39 English wordlist as a replacement for the provided word, as described for
+ * app_seedutils_bip39_neighbors().
+ *
+ * Args:
+ *     word: the word being replaced
+ *     word_len: the number of characters in word
+ *     wordi: the index of the replacement word in the wordlist; must be in [0, 2047]
+ * Returns:
+ *     the rank, in [0, 3]; lower is better
+ */
+static uint8_t app_seedutils_bip39_neighbor_rank(const char *word, uint8_t word_len, uint16_t wordi);
+
 //----------------------------------------------------------------------------//
 //                                                                            //
 //                       External Function Definitions                        //
 //                                                                            //
 //----------------------------------------------------------------------------//
 
-uint8_t app_seedutils_bip39_next_letters(const char *word, uint8_t word_len, char *letters_dest, bool *complete,
-		int16_t *prediction) {
-	if (word_len == 0) {
+uint8_t app_seedutils_bip39_next_letters(const char *word, uint8_t word_len, char *letters_dest, uint16_t *counts_dest,
+		bool *complete, int16_t *prediction) {
+	// The letter counts for the empty word are only known by scanning the wordlist
+	if (word_len == 0 && counts_dest == NULL) {
 		if (complete != NULL)
 			*complete = false;
 		if (prediction != NULL)
@@ -90,44 +166,87 @@ uint8_t app_seedutils_bip39_next_letters(const char *word, uint8_t word_len, cha
 		return 0;
 	}
 	uint32_t letters_found = 0; // Bit array representing letters found, in alpha order starting at most significant bit
+	uint16_t letter_counts[26]; // Number of words continuing with each letter, in alpha order
+	os_memset(letter_counts, 0, sizeof(letter_counts));
 	bool comp = false;
-	uint16_t valid_words = 0; // Number of words for which word is a prefix
-	uint16_t valid_wordi; // Index of the last word for which word is a prefix
-	for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+	// Only the words for which word is a prefix need to be examined
+	uint16_t first = 0;
+	uint16_t valid_words = app_seedutils_bip39_prefix_range(word, word_len, &first);
+	for (uint16_t wordi = first; wordi < first + valid_words; wordi++) {
 		uint16_t offset = app_seedutils_bip39_wordlist_offsets[wordi];
 		uint16_t len = app_seedutils_bip39_wordlist_offsets[wordi + 1] - offset;
-		if (len < word_len || (comp && len == word_len))
-			goto next_word;
-		const char *w = &app_seedutils_bip39_wordlist_words[offset];
-		for (uint8_t i = 0; i < word_len; i++) {
-			if (w[i] != word[i])
-				goto next_word;
-		}
-		valid_words++;
-		valid_wordi = wordi;
 		if (len == word_len) {
 			comp = true;
-			goto next_word;
+			continue;
 		}
-		char next = w[word_len];
+		char next = app_seedutils_bip39_wordlist_words[offset + word_len];
 		letters_found |= ((uint32_t) 1 << 25) >> (next - 'a');
-	next_word:
-		continue;
+		letter_counts[next - 'a']++;
 	}
 	if (complete != NULL)
 		*complete = comp;
 	if (prediction != NULL)
-		*prediction = valid_words == 1 ? valid_wordi : -1;
+		*prediction = valid_words == 1 ? first : -1;
 	uint8_t n_found = 0;
 	for (uint8_t i = 0; i < 26; i++) {
 		if (((letters_found << i) & ((uint32_t) 1 << 25)) != 0) {
 			n_found++;
 			*letters_dest++ = 'a' + i;
+			if (counts_dest != NULL)
+				*counts_dest++ = letter_counts[i];
 		}
 	}
 	return n_found;
 }
 
+void app_seedutils_order_letters(char *letters, const uint16_t *counts, uint8_t letters_size) {
+	uint8_t depths[26];
+	char original[26];
+	os_memcpy(original, letters, letters_size);
+	app_seedutils_split_depths(depths, letters_size, 0);
+	uint32_t placed = 0; // Bit array of the letters already placed, indexed by position in original
+	// Fill positions from shallowest to deepest (left to right within a depth) with letters from heaviest to lightest
+	for (uint8_t depth = 0, n_placed = 0; n_placed < letters_size; depth++) {
+		for (uint8_t pos = 0; pos < letters_size; pos++) {
+			if (depths[pos] != depth)
+				continue;
+			int8_t heaviest = -1;
+			for (uint8_t i = 0; i < letters_size; i++) {
+				if ((placed & ((uint32_t) 1 << i)) == 0 && (heaviest == -1 || counts[i] > counts[heaviest]))
+					heaviest = i;
+			}
+			letters[pos] = original[heaviest];
+			placed |= (uint32_t) 1 << heaviest;
+			n_placed++;
+		}
+	}
+}
+
+uint16_t app_seedutils_bip39_prefix_range(const char *word, uint8_t word_len, uint16_t *first_dest) {
+	// Binary search for the first word not ordered before word, then for the first word ordered after word
+	uint16_t lo = 0;
+	uint16_t hi = APP_SEEDUTILS_WORD_COUNT;
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2;
+		if (app_seedutils_bip39_prefix_cmp(mid, word, word_len) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	uint16_t first = lo;
+	hi = APP_SEEDUTILS_WORD_COUNT;
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2;
+		if (app_seedutils_bip39_prefix_cmp(mid, word, word_len) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (first != lo && first_dest != NULL)
+		*first_dest = first;
+	return lo - first;
+}
+
 const char* app_seedutils_bip39_word(uint16_t index, uint8_t *word_len_dest) {
 	uint16_t offset = app_seedutils_bip39_wordlist_offsets[index];
 	if (word_len_dest != NULL)
@@ -136,68 +255,92 @@ const char* app_seedutils_bip39_word(uint16_t index, uint8_t *word_len_dest) {
 }
 
 uint16_t app_seedutils_bip39_index(const char *word, uint8_t word_len) {
-	// TODO This could be heavily optimized by performing a binary search instead
 	if (word_len < APP_SEEDUTILS_WORD_LEN_MIN || word_len > APP_SEEDUTILS_WORD_LEN_MAX)
-		goto not_found;
-	uint16_t wordi = 0;
-	uint16_t chari = 0;
-	for (; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+		return APP_SEEDUTILS_WORD_COUNT;
+	// Binary search for the first word beginning with word; since a word is ordered before every longer word it is a
+	// prefix of (e.g. "act" before "action"), this is the only candidate for an exact match
+	uint16_t lo = 0;
+	uint16_t hi = APP_SEEDUTILS_WORD_COUNT;
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2;
+		if (app_seedutils_bip39_prefix_cmp(mid, word, word_len) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == APP_SEEDUTILS_WORD_COUNT || app_seedutils_bip39_prefix_cmp(lo, word, word_len) != 0)
+		return APP_SEEDUTILS_WORD_COUNT;
+	if (app_seedutils_bip39_wordlist_offsets[lo + 1] - app_seedutils_bip39_wordlist_offsets[lo] != word_len)
+		return APP_SEEDUTILS_WORD_COUNT;
+	return lo;
+}
+
+uint8_t app_seedutils_bip39_neighbors(const char *word, uint8_t word_len, uint16_t *neighbors_dest,
+		uint8_t neighbors_max) {
+	uint8_t count = 0;
+	for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
 		uint16_t offset = app_seedutils_bip39_wordlist_offsets[wordi];
-		uint16_t len = app_seedutils_bip39_wordlist_offsets[wordi + 1] - offset;
-		if (len != word_len)
-			goto next_word;
-		const char *w = &app_seedutils_bip39_wordlist_words[offset];
-		for (uint8_t i = 0; i < len; i++) {
-			if (w[i] != word[i])
-				goto next_word;
-		}
-		return wordi;
-	next_word:
-		chari += len;
+		uint8_t len = app_seedutils_bip39_wordlist_offsets[wordi + 1] - offset;
+		if (len + 1 < word_len || len > word_len + 1)
+			continue;
+		if (!app_seedutils_one_edit(word, word_len, &app_seedutils_bip39_wordlist_words[offset], len))
+			continue;
+		// Insert the word after every word of the same or better rank, dropping the worst word if there is no room left
+		uint8_t rank = app_seedutils_bip39_neighbor_rank(word, word_len, wordi);
+		uint8_t i = count;
+		while (i != 0 && app_seedutils_bip39_neighbor_rank(word, word_len, neighbors_dest[i - 1]) > rank)
+			i--;
+		if (i == neighbors_max)
+			continue;
+		if (count < neighbors_max)
+			count++;
+		for (uint8_t j = count - 1; j > i; j--)
+			neighbors_dest[j] = neighbors_dest[j - 1];
+		neighbors_dest[i] = wordi;
 	}
-not_found:
-	return APP_SEEDUTILS_WORD_COUNT;
+	return count;
 }
 
-bool app_seedutils_compare(char *mnemonic, uint8_t mnemonic_len) {
-	// This will eventually store the master private key at arg_node[0:32] and the master chain code at arg_node[32:64],
-	// both of which are derived from the argument mnemonic.
-	uint8_t arg_node[64];
-	// Generate the seed data according to BIP 39, and store it in arg_node[0:64]. This will be used as the 512 bits of
-	// entropy from which the BIP 32 master node is derived.
+void app_seedutils_bip39_seed(char *mnemonic, uint8_t mnemonic_len, uint8_t *seed_dest) {
 	if (mnemonic_len > 128) {
 		cx_hash_sha512((unsigned char*) mnemonic, mnemonic_len, (unsigned char*) mnemonic);
 		mnemonic_len = 64;
 	}
-	{
-		uint8_t passphrase[12];
-		os_memcpy(passphrase, "mnemonic\0\0\0", 12);
-		cx_pbkdf2_sha512((unsigned char*) mnemonic, mnemonic_len, passphrase, sizeof(passphrase), 2048, arg_node, 64);
-	}
-	// Calculate the master private key (stored in arg_node[0:32]) and master chain code (stored in arg_node[32:64])
+	uint8_t passphrase[12];
+	os_memcpy(passphrase, "mnemonic\0\0\0", 12);
+	cx_pbkdf2_sha512((unsigned char*) mnemonic, mnemonic_len, passphrase, sizeof(passphrase), 2048, seed_dest, 64);
+}
+
+void app_seedutils_derive_master_node(const uint8_t *seed, uint8_t *node_dest) {
+	// Calculate the master private key (stored in node_dest[0:32]) and master chain code (stored in node_dest[32:64])
 	// according to BIP 32. Both the master private key and master chain code are big-endian 256-bit integers.
-	cx_hmac_sha512((unsigned char*) "Bitcoin seed", 12, arg_node, 64, arg_node);
-	// Derive the node m / app_seedutils_compare_path (hardened) using the seed derived from the argument mnemonic. The
-	// child private key is stored in arg_node[0:32] and the child chain code is stored in arg_node[32:64].
-	{
+	cx_hmac_sha512((unsigned char*) "Bitcoin seed", 12, (unsigned char*) seed, 64, node_dest);
+}
+
+void app_seedutils_derive_path(const uint8_t *node, const uint32_t *path, uint8_t path_len, uint8_t *node_dest) {
+	if (node_dest != node)
+		os_memcpy(node_dest, node, 64);
+	for (uint8_t i = 0; i < path_len; i++) {
+		// Derive the hardened child path[i] of the node in node_dest. The child private key is stored in
+		// node_dest[0:32] and the child chain code is stored in node_dest[32:64].
 		uint8_t temp[65];
 		temp[0] = 0;
-		os_memcpy(temp + 1, arg_node, 32);
+		os_memcpy(temp + 1, node_dest, 32);
 		while (true) {
 			bool failed = false;
 
 			// Store path in temp[33:37], big-endian
-			temp[33] = (app_seedutils_compare_path >> 24) & 0xFF;
-			temp[34] = (app_seedutils_compare_path >> 16) & 0xFF;
-			temp[35] = (app_seedutils_compare_path >> 8) & 0xFF;
-			temp[36] = (app_seedutils_compare_path) & 0xFF;
+			temp[33] = (path[i] >> 24) & 0xFF;
+			temp[34] = (path[i] >> 16) & 0xFF;
+			temp[35] = (path[i] >> 8) & 0xFF;
+			temp[36] = (path[i]) & 0xFF;
 
-			cx_hmac_sha512(arg_node + 32, 32, temp, 37, temp);
+			cx_hmac_sha512(node_dest + 32, 32, temp, 37, temp);
 
 			if (cx_math_cmp(temp, (uint8_t*) app_seedutils_secp256k1_order, 32) >= 0) {
 				failed = true;
 			} else {
-				cx_math_addm(temp, temp, arg_node, (uint8_t*) app_seedutils_secp256k1_order, 32);
+				cx_math_addm(temp, temp, node_dest, (uint8_t*) app_seedutils_secp256k1_order, 32);
 				failed = cx_math_is_zero(temp, 32) != 0;
 			}
 			if (!failed)
@@ -205,12 +348,16 @@ bool app_seedutils_compare(char *mnemonic, uint8_t mnemonic_len) {
 			temp[0] = 1;
 			os_memmove(temp + 1, temp + 32, 32);
 		}
-		os_memcpy(arg_node, temp, 32);
-		os_memcpy(arg_node + 32, temp + 32, 32);
+		os_memcpy(node_dest, temp, 64);
 	}
-	// Derive the node m / app_seedutils_compare_path (hardened) from the device master seed using a syscall.
+}
+
+bool app_seedutils_compare_node(const uint8_t *master_node, const uint32_t *path, uint8_t path_len) {
+	uint8_t arg_node[64];
+	app_seedutils_derive_path(master_node, path, path_len, arg_node);
+	// Derive the same node from the device master seed using a syscall.
 	uint8_t dev_node[64];
-	os_perso_derive_node_bip32(CX_CURVE_SECP256K1, (uint32_t*) &app_seedutils_compare_path, 1, dev_node, dev_node + 32);
+	os_perso_derive_node_bip32(CX_CURVE_SECP256K1, (uint32_t*) path, path_len, dev_node, dev_node + 32);
 	// Compare argument derived node to device derived node
 	for (uint8_t i = 0; i < 64; i++) {
 		if (arg_node[i] != dev_node[i])
@@ -219,7 +366,90 @@ bool app_seedutils_compare(char *mnemonic, uint8_t mnemonic_len) {
 	return true;
 }
 
+bool app_seedutils_compare(char *mnemonic, uint8_t mnemonic_len) {
+	// This will store the BIP 32 master node derived from the argument mnemonic.
+	uint8_t arg_node[64];
+	// Generate the seed data according to BIP 39, and store it in arg_node[0:64]. This will be used as the 512 bits of
+	// entropy from which the BIP 32 master node is derived.
+	app_seedutils_bip39_seed(mnemonic, mnemonic_len, arg_node);
+	app_seedutils_derive_master_node(arg_node, arg_node);
+	// Compare the node m / app_seedutils_compare_path (hardened) derived from both master nodes
+	return app_seedutils_compare_node(arg_node, &app_seedutils_compare_path, 1);
+}
+
+void app_seedutils_node_fingerprint(const uint8_t *node, uint8_t *fingerprint_dest) {
+	// Calculate the public key of the node. Only the public key leaves this function, so the private key is wiped
+	// right away.
+	cx_ecfp_private_key_t private_key;
+	cx_ecfp_public_key_t public_key;
+	cx_ecfp_init_private_key(CX_CURVE_SECP256K1, (unsigned char*) node, 32, &private_key);
+	cx_ecfp_generate_pair(CX_CURVE_SECP256K1, &public_key, &private_key, 1);
+	os_memset(&private_key, 0, sizeof(private_key));
+	// The public key is stored as 0x04 || x || y; compress it to (0x02 or 0x03 depending on the parity of y) || x
+	uint8_t compressed[33];
+	compressed[0] = (public_key.W[64] & 1) != 0 ? 0x03 : 0x02;
+	os_memcpy(compressed + 1, public_key.W + 1, 32);
+	uint8_t hash[32];
+	cx_hash_sha256(compressed, sizeof(compressed), hash);
+	cx_ripemd160_t ripemd160;
+	cx_ripemd160_init(&ripemd160);
+	cx_hash((cx_hash_t*) &ripemd160, CX_LAST, hash, sizeof(hash), fingerprint_dest);
+}
+
+void app_seedutils_device_fingerprint(uint8_t *fingerprint_dest) {
+	// Derive the node m / app_seedutils_compare_path (hardened) from the device master seed using a syscall
+	uint8_t node[64];
+	os_perso_derive_node_bip32(CX_CURVE_SECP256K1, (uint32_t*) &app_seedutils_compare_path, 1, node, node + 32);
+	app_seedutils_node_fingerprint(node, fingerprint_dest);
+	os_memset(node, 0, sizeof(node));
+}
+
+uint8_t app_seedutils_bip39_indices(const char *mnemonic, uint8_t mnemonic_len, uint16_t *indices_dest) {
+	const char *end = mnemonic + mnemonic_len;
+	uint8_t word_count = 0;
+	while (true) {
+		if (word_count == APP_SEEDUTILS_SEED_LENGTH_MAX)
+			return 0;
+		const char *word = mnemonic;
+		while (mnemonic != end && *mnemonic != ' ')
+			mnemonic++;
+		indices_dest[word_count++] = app_seedutils_bip39_index(word, mnemonic - word);
+		if (mnemonic == end)
+			return word_count;
+		mnemonic++; // Skip the space
+	}
+}
+
+void app_seedutils_bip39_pack(const uint16_t *indices, uint8_t word_count, uint8_t *ent_dest) {
+	// Shift each index into an accumulator and flush every whole byte; at most 7 + 11 bits are ever pending
+	uint8_t *dest = ent_dest;
+	uint32_t acc = 0;
+	uint8_t acc_bits = 0;
+	for (uint8_t i = 0; i < word_count; i++) {
+		acc = (acc << 11) | indices[i];
+		acc_bits += 11;
+		while (acc_bits >= 8) {
+			acc_bits -= 8;
+			*dest++ = acc >> acc_bits;
+		}
+	}
+	if (acc_bits != 0)
+		*dest++ = acc << (8 - acc_bits);
+	os_memset(dest, 0, ent_dest + APP_SEEDUTILS_ENT_SIZE - dest);
+}
+
+void app_seedutils_bip39_unpack(const uint8_t *ent, uint8_t word_count, uint16_t *indices_dest) {
+	for (uint8_t i = 0; i < word_count; i++)
+		indices_dest[i] = app_seedutils_get_uint11(ent, i);
+}
+
 bool app_seedutils_valid_checksum(const char *mnemonic, uint8_t mnemonic_len) {
+	uint16_t indices[APP_SEEDUTILS_SEED_LENGTH_MAX];
+	uint8_t word_count = app_seedutils_bip39_indices(mnemonic, mnemonic_len, indices);
+	return app_seedutils_valid_checksum_indices(indices, word_count);
+}
+
+bool app_seedutils_valid_checksum_indices(const uint16_t *indices, uint8_t word_count) {
 	// 12 word mnemonic:
 	// ent[bit 0 : bit 128] = ENT
 	// ent[bit 128 : bit 132] = CS
@@ -231,37 +461,53 @@ bool app_seedutils_valid_checksum(const char *mnemonic, uint8_t mnemonic_len) {
 	// 24 word mnemonic:
 	// ent[bit 0 : bit 256] = ENT
 	// ent[bit 256 : bit 264] = CS
-	uint8_t ent[33];
-	os_memset(ent, 0, sizeof(ent));
-	uint8_t word_count = 0;
-	do {
-		uint8_t word_len = 0;
-		for (const char *word = mnemonic; *word != ' ' && *word != '\0'; word++)
-			word_len++;
-		app_seedutils_set_uint11(ent, word_count, app_seedutils_bip39_index(mnemonic, word_len));
-		mnemonic += word_len;
-		word_count++;
-	} while (*mnemonic++ != '\0');
-	switch (word_count) {
-	case 12: {
-		uint8_t hash[32];
-		cx_hash_sha256(ent, 16, hash);
-		return ent[16] == (hash[0] & 0xF0);
-	} break;
-	case 18: {
-		uint8_t hash[32];
-		cx_hash_sha256(ent, 24, hash);
-		return ent[24] == (hash[0] & 0xFC);
-	} break;
-	case 24: {
-		uint8_t hash[32];
-		cx_hash_sha256(ent, 32, hash);
-		return ent[32] == hash[0];
-	} break;
-	// Impossible case
-	default:
+	if (word_count != 12 && word_count != 18 && word_count != 24)
 		return false;
+	for (uint8_t i = 0; i < word_count; i++) {
+		if (indices[i] >= APP_SEEDUTILS_WORD_COUNT)
+			return false;
+	}
+	uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+	app_seedutils_bip39_pack(indices, word_count, ent);
+	// ENT is word_count * 32 / 3 bits long (always a whole number of bytes), and CS is the first word_count / 3 bits of
+	// SHA-256(ENT)
+	uint8_t ent_size = word_count * 4 / 3;
+	uint8_t hash[32];
+	cx_hash_sha256(ent, ent_size, hash);
+	return ent[ent_size] == (hash[0] & (0xFF << (8 - word_count / 3)));
+}
+
+uint16_t app_seedutils_checksum_next(const uint16_t *indices, uint8_t word_count, uint8_t slot, uint16_t start) {
+	if (word_count != 12 && word_count != 18 && word_count != 24)
+		return APP_SEEDUTILS_WORD_COUNT;
+	// Pack every word once, with the one at slot left zero; each candidate is then spliced into the three bytes of the
+	// 24-bit window holding the slot, which hold their packed bits again before every candidate
+	uint16_t base[APP_SEEDUTILS_SEED_LENGTH_MAX];
+	os_memcpy(base, indices, word_count * sizeof(uint16_t));
+	base[slot] = 0;
+	uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+	app_seedutils_bip39_pack(base, word_count, ent);
+	uint16_t desti = slot * 11;
+	uint8_t first = desti / 8;
+	uint8_t last = app_seedutils_uint11_last(desti);
+	uint8_t shift = 13 - desti % 8;
+	uint8_t first_base = ent[first];
+	uint8_t second_base = ent[first + 1];
+	uint8_t last_base = ent[last];
+	uint8_t ent_size = word_count * 4 / 3;
+	uint8_t cs_mask = 0xFF << (8 - word_count / 3);
+	for (uint16_t candidate = start; candidate < APP_SEEDUTILS_WORD_COUNT; candidate++) {
+		uint32_t window = (uint32_t) candidate << shift;
+		// As in app_seedutils_set_uint11(), the last byte may alias the second and is written first
+		ent[last] = last_base | (uint8_t) window;
+		ent[first + 1] = second_base | (uint8_t) (window >> 8);
+		ent[first] = first_base | (uint8_t) (window >> 16);
+		uint8_t hash[32];
+		cx_hash_sha256(ent, ent_size, hash);
+		if (ent[ent_size] == (hash[0] & cs_mask))
+			return candidate;
 	}
+	return APP_SEEDUTILS_WORD_COUNT;
 }
 
 //----------------------------------------------------------------------------//
@@ -270,30 +516,79 @@ bool app_seedutils_valid_checksum(const char *mnemonic, uint8_t mnemonic_len) {
 //                                                                            //
 //----------------------------------------------------------------------------//
 
-// +========+=================+=================+=================+
-// | dest_i | arr[0] = n >> x | arr[1] = n >> x | arr[2] = n >> x |
-// +========+=================+=================+=================+
-// |      0 |               3 |              -5 |             N/A |
-// |      1 |               4 |              -4 |             N/A |
-// |      2 |               5 |              -3 |             N/A |
-// |      3 |               6 |              -2 |             N/A |
-// |      4 |               7 |              -1 |             N/A |
-// |      5 |               8 |               0 |             N/A |
-// |      6 |               9 |               1 |              -7 |
-// |      7 |              10 |               2 |              -6 |
-// +========+=================+=================+=================+
+// Each 11-bit sequence lies within a 24-bit big-endian window beginning at arr[i * 11 / 8], shifted left by
+// 13 - (i * 11 % 8) bits. The third byte of the window is only touched when the sequence actually extends into it, so
+// that the last word of a 24 word mnemonic never reads or writes past the end of a APP_SEEDUTILS_ENT_SIZE byte array.
 void app_seedutils_set_uint11(uint8_t *arr, uint8_t i, uint16_t n) {
 	uint16_t desti = i * 11;
-	arr += desti / 8;
-	desti %= 8;
-	// Write to first byte
-	arr[0] |= n >> (desti + 3);
-	// Write to second byte
-	if (desti <= 4)
-		arr[1] |= (n << (5 - desti)) & 0xFF;
-	if (desti >= 5)
-		arr[1] |= (n >> (desti - 5)) & 0xFF;
-	// Write to third byte
-	if (desti >= 6)
-		arr[2] |= (n << (13 - desti)) & 0xFF;
+	uint32_t window = (uint32_t) n << (13 - desti % 8);
+	// The last byte is written first, since it may alias the second byte, to which its part of the window is then 0
+	arr[app_seedutils_uint11_last(desti)] |= window;
+	arr[desti / 8 + 1] |= window >> 8;
+	arr[desti / 8] |= window >> 16;
 }
+
+uint16_t app_seedutils_get_uint11(const uint8_t *arr, uint8_t i) {
+	uint16_t desti = i * 11;
+	uint32_t window = ((uint32_t) arr[desti / 8] << 16) | ((uint32_t) arr[desti / 8 + 1] << 8) |
+			arr[app_seedutils_uint11_last(desti)];
+	return (window >> (13 - desti % 8)) & 0x7FF;
+}
+
+static uint8_t app_seedutils_uint11_last(uint16_t desti) {
+	uint8_t last = desti / 8 + 2;
+	return last - (last >= APP_SEEDUTILS_ENT_SIZE);
+}
+
+static void app_seedutils_split_depths(uint8_t *depths, uint8_t n, uint8_t depth) {
+	if (n == 0)
+		return;
+	if (n == 1) {
+		depths[0] = depth;
+		return;
+	}
+	uint8_t left = (n + 1) / 2;
+	app_seedutils_split_depths(depths, left, depth + 1);
+	app_seedutils_split_depths(depths + left, n - left, depth + 1);
+}
+
+static int8_t app_seedutils_bip39_prefix_cmp(uint16_t wordi, const char *prefix, uint8_t prefix_len) {
+	uint16_t offset = app_seedutils_bip39_wordlist_offsets[wordi];
+	uint16_t len = app_seedutils_bip39_wordlist_offsets[wordi + 1] - offset;
+	const char *w = &app_seedutils_bip39_wordlist_words[offset];
+	for (uint8_t i = 0; i < prefix_len; i++) {
+		if (i == len)
+			return -1;
+		if (w[i] != prefix[i])
+			return w[i] < prefix[i] ? -1 : 1;
+	}
+	return 0;
+}
+
+static bool app_seedutils_one_edit(const char *a, uint8_t a_len, const char *b, uint8_t b_len) {
+	// Skip the common prefix, then the remainders must match after undoing the single edit at the first difference
+	uint8_t i = 0;
+	while (i < a_len && i < b_len && a[i] == b[i])
+		i++;
+	if (a_len == b_len) {
+		if (i == a_len)
+			return true;
+		if (os_memcmp(&a[i + 1], &b[i + 1], a_len - i - 1) == 0)
+			return true;
+		return i + 1 < a_len && a[i] == b[i + 1] && a[i + 1] == b[i] &&
+				os_memcmp(&a[i + 2], &b[i + 2], a_len - i - 2) == 0;
+	}
+	if (a_len == b_len + 1)
+		return os_memcmp(&a[i + 1], &b[i], b_len - i) == 0;
+	if (b_len == a_len + 1)
+		return os_memcmp(&a[i], &b[i + 1], a_len - i) == 0;
+	return false;
+}
+
+static uint8_t app_seedutils_bip39_neighbor_rank(const char *word, uint8_t word_len, uint16_t wordi) {
+	uint16_t offset = app_seedutils_bip39_wordlist_offsets[wordi];
+	uint16_t len = app_seedutils_bip39_wordlist_offsets[wordi + 1] - offset;
+	bool same_first = word_len != 0 && app_seedutils_bip39_wordlist_words[offset] == word[0];
+	return (same_first ? 0 : 2) + (len == word_len ? 0 : 1);
+}
+
@@ -0,0 +1,219 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "app_telemetry.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "os.h"
+
+#include "app.h"
+
+#if APP_DEBUG
+
+#define APP_TELEMETRY_SLOT_NONE 0xFF
+#define APP_TELEMETRY_DWELL_UNIT 100
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                  Internal Type Declarations & Definitions                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+typedef struct {
+	// The total time spent entering this word, in units of APP_TELEMETRY_DWELL_UNIT milliseconds
+	uint16_t dwell;
+	// The number of times this word was selected for entry
+	uint8_t visits;
+	// The number of button presses on the keyboard, including those that erased a letter
+	uint8_t keystrokes;
+	// The number of button presses on the keyboard that erased a letter
+	uint8_t backspaces;
+	// The number of offered words that were chosen
+	uint8_t predictions_accepted;
+	// The number of offered words that were rejected
+	uint8_t predictions_rejected;
+	// The number of frames drawn while entering this word
+	uint8_t redraws;
+} app_telemetry_slot_t;
+
+typedef struct {
+	// The number of BUI_EVENT_DISPLAYED events handled
+	uint16_t displayed;
+	// The number of BUI_EVENT_TIME_ELAPSED events handled
+	uint16_t time_elapsed;
+	// The number of BUI_EVENT_BUTTON_CLICKED events handled
+	uint16_t button_clicked;
+	// The number of frames drawn
+	uint16_t redraws;
+} app_telemetry_counters_t;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                Internal Variable Declarations & Definitions                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Internal Non-const (RAM) Variable Definitions
+ */
+
+static app_telemetry_counters_t app_telemetry_counters;
+static app_telemetry_slot_t app_telemetry_slots[24];
+static uint8_t app_telemetry_seed_length;
+static uint8_t app_telemetry_slot; // The index of the slot being recorded, or APP_TELEMETRY_SLOT_NONE
+static uint8_t app_telemetry_dwell_rem; // Milliseconds elapsed in the current slot not yet added to its dwell time
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_telemetry_inc(uint8_t *count);
+static void app_telemetry_inc16(uint16_t *count);
+static uint8_t* app_telemetry_dump_uint16(uint8_t *dest, uint16_t n);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+void app_telemetry_session_begin(uint8_t seed_length) {
+	os_memset(&app_telemetry_counters, 0, sizeof(app_telemetry_counters));
+	os_memset(app_telemetry_slots, 0, sizeof(app_telemetry_slots));
+	app_telemetry_seed_length = seed_length;
+	app_telemetry_slot = APP_TELEMETRY_SLOT_NONE;
+	app_telemetry_dwell_rem = 0;
+}
+
+void app_telemetry_slot_begin(uint8_t slot) {
+	app_telemetry_slot = slot;
+	app_telemetry_dwell_rem = 0;
+	app_telemetry_inc(&app_telemetry_slots[slot].visits);
+}
+
+void app_telemetry_slot_end() {
+	app_telemetry_slot = APP_TELEMETRY_SLOT_NONE;
+}
+
+void app_telemetry_keystroke(bool backspace) {
+	if (app_telemetry_slot == APP_TELEMETRY_SLOT_NONE)
+		return;
+	app_telemetry_inc(&app_telemetry_slots[app_telemetry_slot].keystrokes);
+	if (backspace)
+		app_telemetry_inc(&app_telemetry_slots[app_telemetry_slot].backspaces);
+}
+
+void app_telemetry_prediction(bool accepted) {
+	if (app_telemetry_slot == APP_TELEMETRY_SLOT_NONE)
+		return;
+	if (accepted)
+		app_telemetry_inc(&app_telemetry_slots[app_telemetry_slot].predictions_accepted);
+	else
+		app_telemetry_inc(&app_telemetry_slots[app_telemetry_slot].predictions_rejected);
+}
+
+void app_telemetry_time_elapsed(uint32_t elapsed) {
+	if (app_telemetry_slot == APP_TELEMETRY_SLOT_NONE)
+		return;
+	uint16_t *dwell = &app_telemetry_slots[app_telemetry_slot].dwell;
+	elapsed += app_telemetry_dwell_rem;
+	uint32_t units = elapsed / APP_TELEMETRY_DWELL_UNIT;
+	app_telemetry_dwell_rem = elapsed % APP_TELEMETRY_DWELL_UNIT;
+	*dwell = units >= (uint32_t) (0xFFFF - *dwell) ? 0xFFFF : *dwell + units;
+}
+
+void app_telemetry_event(bui_event_id_t id) {
+	switch (id) {
+	case BUI_EVENT_DISPLAYED:
+		app_telemetry_inc16(&app_telemetry_counters.displayed);
+		break;
+	case BUI_EVENT_TIME_ELAPSED:
+		app_telemetry_inc16(&app_telemetry_counters.time_elapsed);
+		break;
+	case BUI_EVENT_BUTTON_CLICKED:
+		app_telemetry_inc16(&app_telemetry_counters.button_clicked);
+		break;
+	// Other events are not counted
+	default:
+		break;
+	}
+}
+
+void app_telemetry_redraw() {
+	app_telemetry_inc16(&app_telemetry_counters.redraws);
+	if (app_telemetry_slot != APP_TELEMETRY_SLOT_NONE)
+		app_telemetry_inc(&app_telemetry_slots[app_telemetry_slot].redraws);
+}
+
+uint8_t app_telemetry_dump(uint8_t *dest) {
+	uint8_t *start = dest;
+	*dest++ = APP_TELEMETRY_VERSION;
+	*dest++ = app_telemetry_seed_length;
+	*dest++ = app_telemetry_slot;
+	*dest++ = 0;
+	dest = app_telemetry_dump_uint16(dest, app_telemetry_counters.displayed);
+	dest = app_telemetry_dump_uint16(dest, app_telemetry_counters.time_elapsed);
+	dest = app_telemetry_dump_uint16(dest, app_telemetry_counters.button_clicked);
+	dest = app_telemetry_dump_uint16(dest, app_telemetry_counters.redraws);
+	dest = app_telemetry_dump_uint16(dest, app_room_ctx_stack_peak());
+	for (uint8_t i = 0; i < app_telemetry_seed_length; i++) {
+		const app_telemetry_slot_t *slot = &app_telemetry_slots[i];
+		dest = app_telemetry_dump_uint16(dest, slot->dwell);
+		*dest++ = slot->visits;
+		*dest++ = slot->keystrokes;
+		*dest++ = slot->backspaces;
+		*dest++ = slot->predictions_accepted;
+		*dest++ = slot->predictions_rejected;
+		*dest++ = slot->redraws;
+	}
+	return dest - start;
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void app_telemetry_inc(uint8_t *count) {
+	if (*count != 0xFF)
+		(*count)++;
+}
+
+static void app_telemetry_inc16(uint16_t *count) {
+	if (*count != 0xFFFF)
+		(*count)++;
+}
+
+static uint8_t* app_telemetry_dump_uint16(uint8_t *dest, uint16_t n) {
+	*dest++ = n >> 8;
+	*dest++ = n & 0xFF;
+	return dest;
+}
+
+#endif
@@ -27,6 +27,8 @@
 #include "os_io_seproxyhal.h"
 
 #include "app.h"
+#include "app_rooms.h"
+#include "app_telemetry.h"
 
 unsigned char G_io_seproxyhal_spi_buffer[IO_SEPROXYHAL_BUFFER_SIZE_B];
 
@@ -67,6 +69,20 @@ void sample_main() {
 				tx = rx;
 				THROW(0x9000);
 				break;
+#if APP_DEBUG
+			case 0x10: // Dump word entry telemetry
+				tx = app_telemetry_dump(G_io_apdu_buffer);
+				THROW(0x9000);
+				break;
+#endif
+			case 0x20: // Get the public fingerprint of the seed (see app_seedutils_device_fingerprint)
+				// The user must confirm the request on the device, so only accept it from the main menu; the reply is
+				// sent by app_rooms_fingerprint
+				if (!app_room_main_current())
+					THROW(0x6985);
+				bui_room_enter(&app_room_ctx, &app_rooms_fingerprint, NULL, 0);
+				flags |= IO_ASYNCH_REPLY;
+				break;
 			case 0xFF: // Return to dashboard
 				goto return_to_dashboard;
 			default:
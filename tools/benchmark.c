@@ -0,0 +1,430 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Host benchmark for app_seedutils.c.
+ *
+ * Each benchmark calls one function of the app (or the whole backup fingerprint pipeline of fingerprint.c, or a kernel
+ * of pbkdf2_mb.h, or the public keys of ec_mb.h) over a fixed set of inputs until at least BENCHMARK_MIN_NS have
+ * elapsed, and reports the mean time per call (per mnemonic for the kernels, and per key for the public keys) on one
+ * core. Kernels the CPU does not support are skipped. These are host
+ * timings: they show how changes to the code move its cost, not how long the device takes.
+ *
+ * Usage: benchmark [-b baseline] [-o output]
+ *     -b: compare against the results in the given file (as written with -o), and exit with status 1 if any benchmark
+ *         is more than BENCHMARK_TOLERANCE times slower than its baseline
+ *     -o: write the results to the given file, to be used as a baseline later
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "app_seedutils.h"
+
+#include "ec_mb.h"
+#include "pbkdf2_mb.h"
+
+// The least time for which each benchmark runs, in nanoseconds
+#define BENCHMARK_MIN_NS 300000000ull
+// How many times slower than its baseline a benchmark may be before it counts as a regression; host timings are noisy,
+// so only a large slowdown is flagged
+#define BENCHMARK_TOLERANCE 1.5
+// The number of pseudo-random 24 word seeds over which the checksum functions are benchmarked
+#define BENCHMARK_SEEDS 64
+// The most benchmarks a baseline file may contain
+#define BENCHMARK_BASELINE_MAX 32
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                  Internal Type Declarations & Definitions                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+typedef struct {
+	const char *name;
+	// Run one round of the benchmark, and return the number of calls made, or 0 if it cannot run on this CPU
+	uint32_t (*run)();
+} benchmark_t;
+
+typedef struct {
+	char name[64];
+	double ns;
+} benchmark_result_t;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static uint32_t benchmark_next_letters();
+static uint32_t benchmark_bip39_index();
+static uint32_t benchmark_bip39_neighbors();
+static uint32_t benchmark_bip39_pack();
+static uint32_t benchmark_bip39_unpack();
+static uint32_t benchmark_valid_checksum();
+static uint32_t benchmark_checksum_next();
+static uint32_t benchmark_fingerprint();
+static uint32_t benchmark_pbkdf2_portable();
+static uint32_t benchmark_pbkdf2_avx2();
+static uint32_t benchmark_pbkdf2_avx512();
+static uint32_t benchmark_pbkdf2(pbkdf2_mb_kernel_t kernel);
+static uint32_t benchmark_public_keys();
+static uint64_t benchmark_now();
+static uint8_t benchmark_load(const char *path, benchmark_result_t *results_dest);
+static uint32_t benchmark_random();
+static void benchmark_usage();
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static const benchmark_t benchmark_benchmarks[] = {
+	{ "app_seedutils_bip39_next_letters", benchmark_next_letters },
+	{ "app_seedutils_bip39_index", benchmark_bip39_index },
+	{ "app_seedutils_bip39_neighbors", benchmark_bip39_neighbors },
+	{ "app_seedutils_bip39_pack", benchmark_bip39_pack },
+	{ "app_seedutils_bip39_unpack", benchmark_bip39_unpack },
+	{ "app_seedutils_valid_checksum", benchmark_valid_checksum },
+	{ "app_seedutils_checksum_next", benchmark_checksum_next },
+	{ "mnemonic to fingerprint", benchmark_fingerprint },
+	{ "pbkdf2_mb_bip39_seeds (portable)", benchmark_pbkdf2_portable },
+	{ "pbkdf2_mb_bip39_seeds (AVX2)", benchmark_pbkdf2_avx2 },
+	{ "pbkdf2_mb_bip39_seeds (AVX-512)", benchmark_pbkdf2_avx512 },
+	{ "ec_mb_public_keys", benchmark_public_keys },
+};
+
+// Pseudo-random 24 word seeds with valid checksums, and their mnemonics
+static uint16_t benchmark_seeds[BENCHMARK_SEEDS][24];
+static char benchmark_mnemonics[BENCHMARK_SEEDS][24 * (APP_SEEDUTILS_WORD_LEN_MAX + 1)];
+static uint8_t benchmark_mnemonic_lens[BENCHMARK_SEEDS];
+
+// Results are accumulated here so that the compiler cannot discard the calls being timed
+static volatile uint32_t benchmark_sink;
+
+static uint32_t benchmark_random_state = 0x5EED5EED;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                               Main Function                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+int main(int argc, char **argv) {
+	const char *baseline_path = NULL;
+	const char *output_path = NULL;
+	int opt;
+	while ((opt = getopt(argc, argv, "b:o:")) != -1) {
+		switch (opt) {
+		case 'b':
+			baseline_path = optarg;
+			break;
+		case 'o':
+			output_path = optarg;
+			break;
+		default:
+			benchmark_usage();
+			return 2;
+		}
+	}
+	if (optind != argc) {
+		benchmark_usage();
+		return 2;
+	}
+	benchmark_result_t baseline[BENCHMARK_BASELINE_MAX];
+	uint8_t baseline_size = 0;
+	if (baseline_path != NULL) {
+		baseline_size = benchmark_load(baseline_path, baseline);
+		if (baseline_size == 0) {
+			fprintf(stderr, "benchmark: no baseline could be read from %s\n", baseline_path);
+			return 2;
+		}
+	}
+	FILE *output = NULL;
+	if (output_path != NULL) {
+		output = fopen(output_path, "w");
+		if (output == NULL) {
+			perror(output_path);
+			return 2;
+		}
+	}
+	// Generate the seeds, completing each with the first word that gives it a valid checksum
+	for (uint8_t i = 0; i < BENCHMARK_SEEDS; i++) {
+		for (uint8_t j = 0; j < 24; j++)
+			benchmark_seeds[i][j] = benchmark_random() % APP_SEEDUTILS_WORD_COUNT;
+		benchmark_seeds[i][23] = app_seedutils_checksum_next(benchmark_seeds[i], 24, 23, 0);
+		char *dest = benchmark_mnemonics[i];
+		for (uint8_t j = 0; j < 24; j++) {
+			uint8_t word_len;
+			const char *word = app_seedutils_bip39_word(benchmark_seeds[i][j], &word_len);
+			if (j != 0)
+				*dest++ = ' ';
+			memcpy(dest, word, word_len);
+			dest += word_len;
+		}
+		benchmark_mnemonic_lens[i] = dest - benchmark_mnemonics[i];
+	}
+	bool regressed = false;
+	printf("%-34s  %14s  %9s\n", "benchmark", "time per call", "baseline");
+	for (uint8_t i = 0; i < sizeof(benchmark_benchmarks) / sizeof(benchmark_benchmarks[0]); i++) {
+		const benchmark_t *benchmark = &benchmark_benchmarks[i];
+		uint64_t calls = 0;
+		uint64_t start = benchmark_now();
+		uint64_t elapsed;
+		do {
+			uint32_t round_calls = benchmark->run();
+			if (round_calls == 0)
+				break;
+			calls += round_calls;
+			elapsed = benchmark_now() - start;
+		} while (elapsed < BENCHMARK_MIN_NS);
+		if (calls == 0) {
+			printf("%-34s  %14s\n", benchmark->name, "unsupported");
+			continue;
+		}
+		double ns = (double) elapsed / calls;
+		printf("%-34s  %11.0f ns", benchmark->name, ns);
+		for (uint8_t j = 0; j < baseline_size; j++) {
+			if (strcmp(baseline[j].name, benchmark->name) != 0)
+				continue;
+			bool slower = ns > baseline[j].ns * BENCHMARK_TOLERANCE;
+			printf("  %+8.0f%%%s", (ns / baseline[j].ns - 1) * 100, slower ? "  REGRESSED" : "");
+			regressed |= slower;
+			break;
+		}
+		printf("\n");
+		if (output != NULL)
+			fprintf(output, "%s\t%.1f\n", benchmark->name, ns);
+	}
+	if (output != NULL)
+		fclose(output);
+	return regressed ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Every prefix of every word, as the keyboard sees them while a word is typed in.
+ */
+static uint32_t benchmark_next_letters() {
+	uint32_t calls = 0;
+	for (uint16_t i = 0; i < APP_SEEDUTILS_WORD_COUNT; i++) {
+		uint8_t word_len;
+		const char *word = app_seedutils_bip39_word(i, &word_len);
+		for (uint8_t len = 0; len < word_len; len++) {
+			char letters[26];
+			uint16_t counts[26];
+			bool complete;
+			int16_t prediction;
+			benchmark_sink += app_seedutils_bip39_next_letters(word, len, letters, counts, &complete, &prediction);
+			calls++;
+		}
+	}
+	return calls;
+}
+
+static uint32_t benchmark_bip39_index() {
+	for (uint16_t i = 0; i < APP_SEEDUTILS_WORD_COUNT; i++) {
+		uint8_t word_len;
+		const char *word = app_seedutils_bip39_word(i, &word_len);
+		benchmark_sink += app_seedutils_bip39_index(word, word_len);
+	}
+	return APP_SEEDUTILS_WORD_COUNT;
+}
+
+/*
+ * Every word with its last letter replaced, as when a word is misspelled.
+ */
+static uint32_t benchmark_bip39_neighbors() {
+	for (uint16_t i = 0; i < APP_SEEDUTILS_WORD_COUNT; i++) {
+		uint8_t word_len;
+		const char *word = app_seedutils_bip39_word(i, &word_len);
+		char typo[APP_SEEDUTILS_WORD_LEN_MAX];
+		memcpy(typo, word, word_len);
+		typo[word_len - 1] = typo[word_len - 1] == 'z' ? 'a' : typo[word_len - 1] + 1;
+		uint16_t neighbors[8];
+		benchmark_sink += app_seedutils_bip39_neighbors(typo, word_len, neighbors, 8);
+	}
+	return APP_SEEDUTILS_WORD_COUNT;
+}
+
+static uint32_t benchmark_bip39_pack() {
+	for (uint8_t i = 0; i < BENCHMARK_SEEDS; i++) {
+		uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+		app_seedutils_bip39_pack(benchmark_seeds[i], 24, ent);
+		benchmark_sink += ent[i % APP_SEEDUTILS_ENT_SIZE];
+	}
+	return BENCHMARK_SEEDS;
+}
+
+static uint32_t benchmark_bip39_unpack() {
+	for (uint8_t i = 0; i < BENCHMARK_SEEDS; i++) {
+		uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+		memcpy(ent, benchmark_seeds[i], sizeof(ent));
+		uint16_t indices[24];
+		app_seedutils_bip39_unpack(ent, 24, indices);
+		benchmark_sink += indices[i % 24];
+	}
+	return BENCHMARK_SEEDS;
+}
+
+static uint32_t benchmark_valid_checksum() {
+	for (uint8_t i = 0; i < BENCHMARK_SEEDS; i++)
+		benchmark_sink += app_seedutils_valid_checksum(benchmark_mnemonics[i], benchmark_mnemonic_lens[i]);
+	return BENCHMARK_SEEDS;
+}
+
+/*
+ * Every candidate for the last word of a seed, as when recovering a missing word.
+ */
+static uint32_t benchmark_checksum_next() {
+	uint32_t calls = 0;
+	for (uint8_t i = 0; i < 4; i++) {
+		uint16_t next = 0;
+		do {
+			next = app_seedutils_checksum_next(benchmark_seeds[i], 24, 23, next) + 1;
+			calls++;
+		} while (next <= APP_SEEDUTILS_WORD_COUNT);
+	}
+	return calls;
+}
+
+/*
+ * The whole pipeline of fingerprint.c: the checksum check, the key stretching, the derivation of m / 6516080'
+ * (hardened), and its fingerprint.
+ */
+static uint32_t benchmark_fingerprint() {
+	const uint32_t compare_path = APP_SEEDUTILS_COMPARE_PATH;
+	for (uint8_t i = 0; i < 4; i++) {
+		char mnemonic[sizeof(benchmark_mnemonics[0])];
+		memcpy(mnemonic, benchmark_mnemonics[i], benchmark_mnemonic_lens[i]);
+		uint8_t node[64];
+		uint8_t fingerprint[20];
+		benchmark_sink += app_seedutils_valid_checksum(mnemonic, benchmark_mnemonic_lens[i]);
+		app_seedutils_bip39_seed(mnemonic, benchmark_mnemonic_lens[i], node);
+		app_seedutils_derive_master_node(node, node);
+		app_seedutils_derive_path(node, &compare_path, 1, node);
+		app_seedutils_node_fingerprint(node, fingerprint);
+		benchmark_sink += fingerprint[0];
+	}
+	return 4;
+}
+
+static uint32_t benchmark_pbkdf2_portable() {
+	return benchmark_pbkdf2(PBKDF2_MB_PORTABLE);
+}
+
+static uint32_t benchmark_pbkdf2_avx2() {
+	return benchmark_pbkdf2(PBKDF2_MB_AVX2);
+}
+
+static uint32_t benchmark_pbkdf2_avx512() {
+	return benchmark_pbkdf2(PBKDF2_MB_AVX512);
+}
+
+/*
+ * The key stretching of fingerprint.c, with every lane of the kernel filled.
+ */
+static uint32_t benchmark_pbkdf2(pbkdf2_mb_kernel_t kernel) {
+	if (!pbkdf2_mb_supported(kernel))
+		return 0;
+	uint8_t lanes = pbkdf2_mb_lanes(kernel);
+	const char *mnemonics[PBKDF2_MB_LANES_MAX];
+	for (uint8_t i = 0; i < lanes; i++)
+		mnemonics[i] = benchmark_mnemonics[i];
+	uint8_t seeds[PBKDF2_MB_LANES_MAX][64];
+	pbkdf2_mb_bip39_seeds(kernel, mnemonics, benchmark_mnemonic_lens, lanes, seeds);
+	benchmark_sink += seeds[0][0];
+	return lanes;
+}
+
+/*
+ * The public keys of fingerprint.c, in a batch of BENCHMARK_SEEDS keys taken from the seeds.
+ */
+static uint32_t benchmark_public_keys() {
+	uint8_t private_keys[BENCHMARK_SEEDS][32];
+	for (uint8_t i = 0; i < BENCHMARK_SEEDS; i++) {
+		memcpy(private_keys[i], benchmark_seeds[i], 32);
+		// Keep the key below the order of the curve (and above 0)
+		private_keys[i][0] = (private_keys[i][0] & 0x7F) | 0x01;
+	}
+	uint8_t public_keys[BENCHMARK_SEEDS][65];
+	ec_mb_public_keys((const uint8_t (*)[32]) private_keys, BENCHMARK_SEEDS, public_keys);
+	benchmark_sink += public_keys[0][1];
+	return BENCHMARK_SEEDS;
+}
+
+static uint64_t benchmark_now() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/*
+ * Read the results written by a previous run with -o.
+ *
+ * Returns:
+ *     the number of results read, or 0 if the file could not be read
+ */
+static uint8_t benchmark_load(const char *path, benchmark_result_t *results_dest) {
+	FILE *file = fopen(path, "r");
+	if (file == NULL)
+		return 0;
+	uint8_t size = 0;
+	char line[128];
+	while (size < BENCHMARK_BASELINE_MAX && fgets(line, sizeof(line), file) != NULL) {
+		char *tab = strchr(line, '\t');
+		if (tab == NULL || tab - line >= (long) sizeof(results_dest[size].name))
+			continue;
+		memcpy(results_dest[size].name, line, tab - line);
+		results_dest[size].name[tab - line] = '\0';
+		results_dest[size].ns = atof(tab + 1);
+		if (results_dest[size].ns > 0)
+			size++;
+	}
+	fclose(file);
+	return size;
+}
+
+static uint32_t benchmark_random() {
+	// xorshift32
+	benchmark_random_state ^= benchmark_random_state << 13;
+	benchmark_random_state ^= benchmark_random_state >> 17;
+	benchmark_random_state ^= benchmark_random_state << 5;
+	return benchmark_random_state;
+}
+
+static void benchmark_usage() {
+	fprintf(stderr, "Usage: benchmark [-b baseline] [-o output]\n");
+}
@@ -0,0 +1,42 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "bkb_model.h"
+
+#include <stdint.h>
+
+uint8_t bkb_model_presses(uint8_t options_size, uint8_t pos) {
+	// The options still offered are [lo, hi)
+	uint8_t lo = 0;
+	uint8_t hi = options_size;
+	uint8_t presses = 0;
+	do {
+		uint8_t left = (hi - lo + 1) / 2;
+		if (pos < lo + left)
+			hi = lo + left;
+		else
+			lo += left;
+		presses++;
+	} while (hi - lo > 1);
+	return presses;
+}
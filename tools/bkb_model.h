@@ -0,0 +1,52 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * A model of the binary keyboard (bui_bkb) as it is used by app_rooms_enterword, for the host tools.
+ *
+ * The keyboard offers a list of options (the letters of its layout, in order). Each click of the left or right button
+ * narrows the options down to their left or right half, the left half getting the extra option when there is an odd
+ * number of them; once a single option remains, it is typed in. This is the split assumed by
+ * app_seedutils_order_letters(), but it is computed here by following the clicks rather than the way the app computes
+ * it. It is an assumption in both places: it has not been checked against bui_bkb itself, whose source (the bui
+ * submodule) is not part of this tree. If bui_bkb gives the extra option to the right half instead, the press counts
+ * of this model are off for odd numbers of options, and so are the results of the tools built on it.
+ */
+
+#ifndef BKB_MODEL_H_
+#define BKB_MODEL_H_
+
+#include <stdint.h>
+
+/*
+ * Count the clicks needed to type in an option on the binary keyboard.
+ *
+ * Args:
+ *     options_size: the number of options offered by the keyboard; must be at least 1
+ *     pos: the position of the option to type in; must be less than options_size
+ * Returns:
+ *     the number of clicks; at least 1
+ */
+uint8_t bkb_model_presses(uint8_t options_size, uint8_t pos);
+
+#endif
@@ -0,0 +1,459 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ec_mb.h"
+
+// The field prime is p = 2^256 - EC_MB_C, so 2^256 = EC_MB_C (mod p)
+#define EC_MB_C 0x1000003D1ull
+// The number of 4-bit windows in a private key, and so of rows in the comb table
+#define EC_MB_WINDOWS 64
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                  Internal Type Declarations & Definitions                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+typedef unsigned __int128 ec_mb_u128_t;
+
+// A field element, as little-endian 64-bit limbs; any value below 2^256 is allowed, not only values below p
+typedef struct {
+	uint64_t n[4];
+} ec_mb_fe_t;
+
+typedef struct {
+	ec_mb_fe_t x;
+	ec_mb_fe_t y;
+} ec_mb_affine_t;
+
+// A point in Jacobian coordinates: (x / z^2, y / z^3)
+typedef struct {
+	ec_mb_fe_t x;
+	ec_mb_fe_t y;
+	ec_mb_fe_t z;
+	bool infinity;
+} ec_mb_jacobian_t;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void ec_mb_fe_fold(uint64_t *n, ec_mb_u128_t carry, ec_mb_fe_t *r);
+static void ec_mb_fe_add(ec_mb_fe_t *r, const ec_mb_fe_t *a, const ec_mb_fe_t *b);
+static void ec_mb_fe_sub(ec_mb_fe_t *r, const ec_mb_fe_t *a, const ec_mb_fe_t *b);
+static void ec_mb_fe_mul(ec_mb_fe_t *r, const ec_mb_fe_t *a, const ec_mb_fe_t *b);
+static void ec_mb_fe_sqr_n(ec_mb_fe_t *r, const ec_mb_fe_t *a, uint8_t n);
+static void ec_mb_fe_inv(ec_mb_fe_t *r, const ec_mb_fe_t *a);
+static void ec_mb_fe_normalize(ec_mb_fe_t *a);
+static bool ec_mb_fe_is_zero(const ec_mb_fe_t *a);
+static void ec_mb_fe_to_bytes(const ec_mb_fe_t *a, uint8_t *dest);
+static void ec_mb_affine_add(ec_mb_affine_t *r, const ec_mb_affine_t *a, const ec_mb_affine_t *b);
+static void ec_mb_jacobian_double(ec_mb_jacobian_t *r, const ec_mb_jacobian_t *a);
+static void ec_mb_jacobian_add(ec_mb_jacobian_t *r, const ec_mb_jacobian_t *a, const ec_mb_affine_t *b);
+static void ec_mb_build_table();
+static void ec_mb_mul_g(ec_mb_jacobian_t *r, const uint8_t *private_key);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static const ec_mb_fe_t ec_mb_p = { {
+	0xFFFFFFFEFFFFFC2F, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
+} };
+
+// The generator G of secp256k1
+static const ec_mb_affine_t ec_mb_g = {
+	.x = { { 0x59F2815B16F81798, 0x029BFCDB2DCE28D9, 0x55A06295CE870B07, 0x79BE667EF9DCBBAC } },
+	.y = { { 0x9C47D08FFB10D4B8, 0xFD17B448A6855419, 0x5DA4FBFC0E1108A8, 0x483ADA7726A3C465 } },
+};
+
+// ec_mb_table[i][j] is (j + 1) * 16^i * G. Every window adds one entry, so a key k gives kG plus the sum of 16^i G
+// over all windows, which is cancelled by adding ec_mb_offset (the negation of that sum); in return, no entry is the
+// point at infinity.
+static ec_mb_affine_t ec_mb_table[EC_MB_WINDOWS][16];
+static ec_mb_affine_t ec_mb_offset;
+static bool ec_mb_table_built;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+void ec_mb_public_keys(const uint8_t (*private_keys)[32], uint8_t count, uint8_t (*public_keys_dest)[65]) {
+	if (count == 0)
+		return;
+	if (!ec_mb_table_built)
+		ec_mb_build_table();
+	ec_mb_jacobian_t points[EC_MB_BATCH_MAX];
+	// products[i] is the product of the z coordinates of points[0] to points[i]
+	ec_mb_fe_t products[EC_MB_BATCH_MAX];
+	for (uint8_t i = 0; i < count; i++) {
+		ec_mb_mul_g(&points[i], private_keys[i]);
+		if (i == 0)
+			products[i] = points[i].z;
+		else
+			ec_mb_fe_mul(&products[i], &products[i - 1], &points[i].z);
+	}
+	// Invert the product of all z coordinates once, and peel the inverse of each z coordinate off of it from the last
+	ec_mb_fe_t inv;
+	ec_mb_fe_inv(&inv, &products[count - 1]);
+	for (uint8_t i = count; i-- > 0;) {
+		ec_mb_fe_t z_inv;
+		if (i == 0) {
+			z_inv = inv;
+		} else {
+			ec_mb_fe_mul(&z_inv, &inv, &products[i - 1]);
+			ec_mb_fe_mul(&inv, &inv, &points[i].z);
+		}
+		ec_mb_fe_t z_inv2;
+		ec_mb_fe_t z_inv3;
+		ec_mb_fe_mul(&z_inv2, &z_inv, &z_inv);
+		ec_mb_fe_mul(&z_inv3, &z_inv2, &z_inv);
+		ec_mb_fe_t x;
+		ec_mb_fe_t y;
+		ec_mb_fe_mul(&x, &points[i].x, &z_inv2);
+		ec_mb_fe_mul(&y, &points[i].y, &z_inv3);
+		public_keys_dest[i][0] = 0x04;
+		ec_mb_fe_to_bytes(&x, public_keys_dest[i] + 1);
+		ec_mb_fe_to_bytes(&y, public_keys_dest[i] + 33);
+	}
+	memset(points, 0, sizeof(points));
+	memset(products, 0, sizeof(products));
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Store in r the 256-bit value n plus carry * 2^256, reduced below 2^256 (mod p). carry must be less than 2^64.
+ */
+static void ec_mb_fe_fold(uint64_t *n, ec_mb_u128_t carry, ec_mb_fe_t *r) {
+	// Each fold replaces carry * 2^256 by carry * EC_MB_C; the first leaves a carry of at most 1, and the second none
+	for (uint8_t fold = 0; fold < 2; fold++) {
+		ec_mb_u128_t t = carry * EC_MB_C;
+		for (uint8_t i = 0; i < 4; i++) {
+			t += n[i];
+			n[i] = t;
+			t >>= 64;
+		}
+		carry = t;
+	}
+	memcpy(r->n, n, sizeof(r->n));
+}
+
+static void ec_mb_fe_add(ec_mb_fe_t *r, const ec_mb_fe_t *a, const ec_mb_fe_t *b) {
+	uint64_t n[4];
+	ec_mb_u128_t t = 0;
+	for (uint8_t i = 0; i < 4; i++) {
+		t += (ec_mb_u128_t) a->n[i] + b->n[i];
+		n[i] = t;
+		t >>= 64;
+	}
+	ec_mb_fe_fold(n, t, r);
+}
+
+static void ec_mb_fe_sub(ec_mb_fe_t *r, const ec_mb_fe_t *a, const ec_mb_fe_t *b) {
+	// a - b = a + (p - b), where b is first reduced below p so that p - b does not go below 0
+	ec_mb_fe_t neg = *b;
+	ec_mb_fe_normalize(&neg);
+	uint64_t borrow = 0;
+	for (uint8_t i = 0; i < 4; i++) {
+		ec_mb_u128_t t = (ec_mb_u128_t) ec_mb_p.n[i] - neg.n[i] - borrow;
+		neg.n[i] = t;
+		borrow = (t >> 64) != 0;
+	}
+	ec_mb_fe_add(r, a, &neg);
+}
+
+static void ec_mb_fe_mul(ec_mb_fe_t *r, const ec_mb_fe_t *a, const ec_mb_fe_t *b) {
+	uint64_t t[8];
+	memset(t, 0, sizeof(t));
+	for (uint8_t i = 0; i < 4; i++) {
+		ec_mb_u128_t carry = 0;
+		for (uint8_t j = 0; j < 4; j++) {
+			carry += (ec_mb_u128_t) a->n[i] * b->n[j] + t[i + j];
+			t[i + j] = carry;
+			carry >>= 64;
+		}
+		t[i + 4] = carry;
+	}
+	// Fold the high half down: t = lo + hi * 2^256 = lo + hi * EC_MB_C (mod p)
+	uint64_t n[4];
+	ec_mb_u128_t carry = 0;
+	for (uint8_t i = 0; i < 4; i++) {
+		carry += (ec_mb_u128_t) t[i + 4] * EC_MB_C + t[i];
+		n[i] = carry;
+		carry >>= 64;
+	}
+	ec_mb_fe_fold(n, carry, r);
+}
+
+/*
+ * Square a n times.
+ */
+static void ec_mb_fe_sqr_n(ec_mb_fe_t *r, const ec_mb_fe_t *a, uint8_t n) {
+	*r = *a;
+	for (uint8_t i = 0; i < n; i++)
+		ec_mb_fe_mul(r, r, r);
+}
+
+/*
+ * Invert a (which must not be 0) as a^(p - 2), with the addition chain of libsecp256k1: the xN are a^(2^N - 1).
+ */
+static void ec_mb_fe_inv(ec_mb_fe_t *r, const ec_mb_fe_t *a) {
+	ec_mb_fe_t x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t;
+	ec_mb_fe_sqr_n(&t, a, 1);
+	ec_mb_fe_mul(&x2, &t, a);
+	ec_mb_fe_sqr_n(&t, &x2, 1);
+	ec_mb_fe_mul(&x3, &t, a);
+	ec_mb_fe_sqr_n(&t, &x3, 3);
+	ec_mb_fe_mul(&x6, &t, &x3);
+	ec_mb_fe_sqr_n(&t, &x6, 3);
+	ec_mb_fe_mul(&x9, &t, &x3);
+	ec_mb_fe_sqr_n(&t, &x9, 2);
+	ec_mb_fe_mul(&x11, &t, &x2);
+	ec_mb_fe_sqr_n(&t, &x11, 11);
+	ec_mb_fe_mul(&x22, &t, &x11);
+	ec_mb_fe_sqr_n(&t, &x22, 22);
+	ec_mb_fe_mul(&x44, &t, &x22);
+	ec_mb_fe_sqr_n(&t, &x44, 44);
+	ec_mb_fe_mul(&x88, &t, &x44);
+	ec_mb_fe_sqr_n(&t, &x88, 88);
+	ec_mb_fe_mul(&x176, &t, &x88);
+	ec_mb_fe_sqr_n(&t, &x176, 44);
+	ec_mb_fe_mul(&x220, &t, &x44);
+	ec_mb_fe_sqr_n(&t, &x220, 3);
+	ec_mb_fe_mul(&x223, &t, &x3);
+	ec_mb_fe_sqr_n(&t, &x223, 23);
+	ec_mb_fe_mul(&t, &t, &x22);
+	ec_mb_fe_sqr_n(&t, &t, 5);
+	ec_mb_fe_mul(&t, &t, a);
+	ec_mb_fe_sqr_n(&t, &t, 3);
+	ec_mb_fe_mul(&t, &t, &x2);
+	ec_mb_fe_sqr_n(&t, &t, 2);
+	ec_mb_fe_mul(r, &t, a);
+}
+
+/*
+ * Reduce a below p.
+ */
+static void ec_mb_fe_normalize(ec_mb_fe_t *a) {
+	// a >= p exactly when a + EC_MB_C carries out of 256 bits, and then a - p is the low 256 bits of a + EC_MB_C
+	uint64_t n[4];
+	ec_mb_u128_t t = EC_MB_C;
+	for (uint8_t i = 0; i < 4; i++) {
+		t += a->n[i];
+		n[i] = t;
+		t >>= 64;
+	}
+	uint64_t mask = -(uint64_t) t;
+	for (uint8_t i = 0; i < 4; i++)
+		a->n[i] = (n[i] & mask) | (a->n[i] & ~mask);
+}
+
+static bool ec_mb_fe_is_zero(const ec_mb_fe_t *a) {
+	ec_mb_fe_t t = *a;
+	ec_mb_fe_normalize(&t);
+	return (t.n[0] | t.n[1] | t.n[2] | t.n[3]) == 0;
+}
+
+/*
+ * Store a, reduced below p, as 32 big-endian bytes.
+ */
+static void ec_mb_fe_to_bytes(const ec_mb_fe_t *a, uint8_t *dest) {
+	ec_mb_fe_t t = *a;
+	ec_mb_fe_normalize(&t);
+	for (uint8_t i = 0; i < 32; i++)
+		dest[i] = t.n[3 - i / 8] >> (56 - 8 * (i % 8));
+}
+
+/*
+ * Add two affine points, neither of which may be the negation of the other, with a field inversion. This is only used
+ * to build the comb table.
+ */
+static void ec_mb_affine_add(ec_mb_affine_t *r, const ec_mb_affine_t *a, const ec_mb_affine_t *b) {
+	ec_mb_fe_t num;
+	ec_mb_fe_t den;
+	ec_mb_fe_sub(&den, &b->x, &a->x);
+	if (ec_mb_fe_is_zero(&den)) {
+		// a = b: the slope of the tangent is 3x^2 / 2y
+		ec_mb_fe_mul(&num, &a->x, &a->x);
+		ec_mb_fe_t twice;
+		ec_mb_fe_add(&twice, &num, &num);
+		ec_mb_fe_add(&num, &twice, &num);
+		ec_mb_fe_add(&den, &a->y, &a->y);
+	} else {
+		ec_mb_fe_sub(&num, &b->y, &a->y);
+	}
+	ec_mb_fe_t slope;
+	ec_mb_fe_inv(&den, &den);
+	ec_mb_fe_mul(&slope, &num, &den);
+	ec_mb_fe_t x;
+	ec_mb_fe_mul(&x, &slope, &slope);
+	ec_mb_fe_sub(&x, &x, &a->x);
+	ec_mb_fe_sub(&x, &x, &b->x);
+	ec_mb_fe_t y;
+	ec_mb_fe_sub(&y, &a->x, &x);
+	ec_mb_fe_mul(&y, &y, &slope);
+	ec_mb_fe_sub(&r->y, &y, &a->y);
+	r->x = x;
+}
+
+/*
+ * Double a Jacobian point (dbl-2009-l, for curves with a = 0).
+ */
+static void ec_mb_jacobian_double(ec_mb_jacobian_t *r, const ec_mb_jacobian_t *a) {
+	ec_mb_fe_t xx, yy, yyyy, d, e, f, t;
+	ec_mb_fe_mul(&xx, &a->x, &a->x);
+	ec_mb_fe_mul(&yy, &a->y, &a->y);
+	ec_mb_fe_mul(&yyyy, &yy, &yy);
+	// d = 2 * ((x + yy)^2 - xx - yyyy)
+	ec_mb_fe_add(&t, &a->x, &yy);
+	ec_mb_fe_mul(&t, &t, &t);
+	ec_mb_fe_sub(&t, &t, &xx);
+	ec_mb_fe_sub(&t, &t, &yyyy);
+	ec_mb_fe_add(&d, &t, &t);
+	// e = 3 * xx, f = e^2
+	ec_mb_fe_add(&e, &xx, &xx);
+	ec_mb_fe_add(&e, &e, &xx);
+	ec_mb_fe_mul(&f, &e, &e);
+	// z' = 2 * y * z (before y is overwritten, in case r is a)
+	ec_mb_fe_mul(&t, &a->y, &a->z);
+	ec_mb_fe_add(&r->z, &t, &t);
+	// x' = f - 2 * d
+	ec_mb_fe_sub(&t, &f, &d);
+	ec_mb_fe_sub(&r->x, &t, &d);
+	// y' = e * (d - x') - 8 * yyyy
+	ec_mb_fe_sub(&t, &d, &r->x);
+	ec_mb_fe_mul(&t, &e, &t);
+	ec_mb_fe_add(&yyyy, &yyyy, &yyyy);
+	ec_mb_fe_add(&yyyy, &yyyy, &yyyy);
+	ec_mb_fe_add(&yyyy, &yyyy, &yyyy);
+	ec_mb_fe_sub(&r->y, &t, &yyyy);
+	r->infinity = a->infinity;
+}
+
+/*
+ * Add an affine point to a Jacobian point (madd-2007-bl). The cases where the sum is a doubling or the point at
+ * infinity take a slower path; they do not occur for keys in range except by chance of about 2^-256.
+ */
+static void ec_mb_jacobian_add(ec_mb_jacobian_t *r, const ec_mb_jacobian_t *a, const ec_mb_affine_t *b) {
+	if (a->infinity) {
+		r->x = b->x;
+		r->y = b->y;
+		memset(&r->z, 0, sizeof(r->z));
+		r->z.n[0] = 1;
+		r->infinity = false;
+		return;
+	}
+	ec_mb_fe_t z1z1, u2, s2, h, hh, i, j, rr, v, t;
+	ec_mb_fe_mul(&z1z1, &a->z, &a->z);
+	ec_mb_fe_mul(&u2, &b->x, &z1z1);
+	ec_mb_fe_mul(&s2, &b->y, &a->z);
+	ec_mb_fe_mul(&s2, &s2, &z1z1);
+	ec_mb_fe_sub(&h, &u2, &a->x);
+	ec_mb_fe_sub(&rr, &s2, &a->y);
+	if (ec_mb_fe_is_zero(&h)) {
+		if (ec_mb_fe_is_zero(&rr))
+			ec_mb_jacobian_double(r, a);
+		else
+			r->infinity = true;
+		return;
+	}
+	ec_mb_fe_add(&rr, &rr, &rr);
+	ec_mb_fe_mul(&hh, &h, &h);
+	ec_mb_fe_add(&i, &hh, &hh);
+	ec_mb_fe_add(&i, &i, &i);
+	ec_mb_fe_mul(&j, &h, &i);
+	ec_mb_fe_mul(&v, &a->x, &i);
+	// z' = (z + h)^2 - z1z1 - hh (before z is overwritten, in case r is a)
+	ec_mb_fe_add(&t, &a->z, &h);
+	ec_mb_fe_mul(&t, &t, &t);
+	ec_mb_fe_sub(&t, &t, &z1z1);
+	ec_mb_fe_sub(&r->z, &t, &hh);
+	// y' = rr * (v - x') - 2 * y * j, with y * j taken before y is overwritten
+	ec_mb_fe_t yj;
+	ec_mb_fe_mul(&yj, &a->y, &j);
+	ec_mb_fe_add(&yj, &yj, &yj);
+	// x' = rr^2 - j - 2 * v
+	ec_mb_fe_mul(&t, &rr, &rr);
+	ec_mb_fe_sub(&t, &t, &j);
+	ec_mb_fe_sub(&t, &t, &v);
+	ec_mb_fe_sub(&r->x, &t, &v);
+	ec_mb_fe_sub(&t, &v, &r->x);
+	ec_mb_fe_mul(&t, &rr, &t);
+	ec_mb_fe_sub(&r->y, &t, &yj);
+	r->infinity = false;
+}
+
+static void ec_mb_build_table() {
+	ec_mb_affine_t base = ec_mb_g;
+	ec_mb_affine_t sum = ec_mb_g;
+	for (uint8_t i = 0; i < EC_MB_WINDOWS; i++) {
+		ec_mb_table[i][0] = base;
+		for (uint8_t j = 1; j < 16; j++)
+			ec_mb_affine_add(&ec_mb_table[i][j], &ec_mb_table[i][j - 1], &base);
+		if (i != 0)
+			ec_mb_affine_add(&sum, &sum, &base);
+		// The base of the next window is 16 times this one
+		base = ec_mb_table[i][15];
+	}
+	ec_mb_offset.x = sum.x;
+	memset(&ec_mb_offset.y, 0, sizeof(ec_mb_offset.y));
+	ec_mb_fe_sub(&ec_mb_offset.y, &ec_mb_offset.y, &sum.y);
+	ec_mb_table_built = true;
+}
+
+/*
+ * Multiply G by a private key, reading the comb table in constant time.
+ */
+static void ec_mb_mul_g(ec_mb_jacobian_t *r, const uint8_t *private_key) {
+	r->infinity = true;
+	for (uint8_t i = 0; i < EC_MB_WINDOWS; i++) {
+		uint8_t window = (private_key[31 - i / 2] >> (4 * (i % 2))) & 0xF;
+		// Read every entry of the row, keeping only the one selected
+		ec_mb_affine_t entry;
+		memset(&entry, 0, sizeof(entry));
+		for (uint8_t j = 0; j < 16; j++) {
+			uint64_t mask = -(uint64_t) (j == window);
+			for (uint8_t k = 0; k < 4; k++) {
+				entry.x.n[k] |= ec_mb_table[i][j].x.n[k] & mask;
+				entry.y.n[k] |= ec_mb_table[i][j].y.n[k] & mask;
+			}
+		}
+		ec_mb_jacobian_add(r, r, &entry);
+	}
+	ec_mb_jacobian_add(r, r, &ec_mb_offset);
+}
@@ -0,0 +1,54 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Batched secp256k1 public keys for the host tools.
+ *
+ * After the key stretching of pbkdf2_mb.h, calculating the public key of each derived node is the largest cost of
+ * fingerprinting a backup on the host. This calculates public keys with a fixed-base comb: a table of the multiples
+ * 1G to 16G of 16^i G for each 4-bit window i of the private key, built once, so that a key takes 64 point additions
+ * and no doublings. The table entries are read in constant time. The points of a batch are converted back to affine
+ * coordinates together, with a single field inversion (Montgomery's trick). The results are the same as those of
+ * cx_ecfp_generate_pair(), as refcheck checks.
+ */
+
+#ifndef EC_MB_H_
+#define EC_MB_H_
+
+#include <stdint.h>
+
+// The most public keys calculated in one batch
+#define EC_MB_BATCH_MAX 64
+
+/*
+ * Calculate the secp256k1 public keys of a batch of private keys.
+ *
+ * Args:
+ *     private_keys: the 32 byte big-endian private keys; each must be in [1, n - 1], where n is the order of the curve
+ *     count: the number of keys; in [1, EC_MB_BATCH_MAX]
+ *     public_keys_dest: the destination in which to store each public key, uncompressed (0x04 || x || y), in the same
+ *                       format as cx_ecfp_public_key_t.W
+ */
+void ec_mb_public_keys(const uint8_t (*private_keys)[32], uint8_t count, uint8_t (*public_keys_dest)[65]);
+
+#endif
@@ -0,0 +1,316 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Backup fingerprint calculator.
+ *
+ * Reads BIP 39 mnemonics from standard input, one per line, and prints the fingerprint of each of them (as computed by
+ * app_seedutils_node_fingerprint()) in hex, one line for each line of input. By default, this is the fingerprint of
+ * the node m / 6516080' (hardened), which is the fingerprint the app exports with the "get fingerprint" APDU (see
+ * app_seedutils_device_fingerprint()), so a backup can be matched against a device without entering it on the device.
+ * Each mnemonic is checked and stretched once, and each node is derived from the deepest node it shares with the
+ * previous path, using the app's own app_seedutils.c. The two costly steps work on batches of mnemonics: the key
+ * stretching, for as many mnemonics at once as the fastest kernel of pbkdf2_mb.h allows, and the public keys, with
+ * ec_mb.h. A line that is not a valid mnemonic is reported as "invalid", and makes the exit status 1.
+ *
+ * The mnemonics are processed on one core; to use several cores, split the input between several processes (for
+ * example with split or xargs -P).
+ *
+ * Usage: fingerprint [-p path]... [-a]
+ *     -p: compute the fingerprint of the node at the given path instead, written as hardened child indices separated by
+ *         slashes, such as 44'/0'/0' (every index must be hardened); the fingerprints of several paths are printed in
+ *         the order given, separated by spaces
+ *     -a: use the app's own app_seedutils_bip39_seed() and app_seedutils_node_fingerprint() rather than pbkdf2_mb.h
+ *         and ec_mb.h, one mnemonic at a time (this is much slower, but does not depend on the host code)
+ */
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include "app_seedutils.h"
+
+#include "ec_mb.h"
+#include "pbkdf2_mb.h"
+
+// The most paths for which fingerprints may be computed
+#define FINGERPRINT_PATHS_MAX 16
+// The most child indices in a path
+#define FINGERPRINT_PATH_LEN_MAX 10
+// The size of the buffer for each line of input; a mnemonic of 24 of the longest words is 24 * 9 - 1 chars long
+#define FINGERPRINT_LINE_SIZE 1024
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                  Internal Type Declarations & Definitions                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+typedef struct {
+	uint32_t indices[FINGERPRINT_PATH_LEN_MAX];
+	uint8_t len;
+} fingerprint_path_t;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static bool fingerprint_parse_path(const char *str, fingerprint_path_t *path_dest);
+static uint16_t fingerprint_normalize(char *line);
+static bool fingerprint_valid(const char *mnemonic, uint16_t mnemonic_len);
+static void fingerprint_batch(const uint8_t (*seeds)[64], uint8_t count, const fingerprint_path_t *paths,
+		uint8_t paths_size, bool app_code, uint8_t (*fingerprints_dest)[FINGERPRINT_PATHS_MAX][20]);
+static void fingerprint_hash160(const uint8_t *public_key, uint8_t *fingerprint_dest);
+static void fingerprint_usage();
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                               Main Function                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+int main(int argc, char **argv) {
+	fingerprint_path_t paths[FINGERPRINT_PATHS_MAX];
+	uint8_t paths_size = 0;
+	bool app_code = false;
+	int opt;
+	while ((opt = getopt(argc, argv, "p:a")) != -1) {
+		switch (opt) {
+		case 'p':
+			if (paths_size == FINGERPRINT_PATHS_MAX || !fingerprint_parse_path(optarg, &paths[paths_size])) {
+				fingerprint_usage();
+				return 2;
+			}
+			paths_size++;
+			break;
+		case 'a':
+			app_code = true;
+			break;
+		default:
+			fingerprint_usage();
+			return 2;
+		}
+	}
+	if (optind != argc) {
+		fingerprint_usage();
+		return 2;
+	}
+	if (paths_size == 0) {
+		paths[0].indices[0] = APP_SEEDUTILS_COMPARE_PATH;
+		paths[0].len = 1;
+		paths_size = 1;
+	}
+	pbkdf2_mb_kernel_t kernel = pbkdf2_mb_best();
+	uint8_t lanes = app_code ? 1 : pbkdf2_mb_lanes(kernel);
+	// Lines are read in batches of one per lane, and the valid mnemonics among them are stretched together
+	static char lines[PBKDF2_MB_LANES_MAX][FINGERPRINT_LINE_SIZE];
+	bool all_valid = true;
+	bool eof = false;
+	while (!eof) {
+		bool valid[PBKDF2_MB_LANES_MAX];
+		const char *mnemonics[PBKDF2_MB_LANES_MAX];
+		uint8_t mnemonic_lens[PBKDF2_MB_LANES_MAX];
+		uint8_t lines_size = 0;
+		uint8_t batch_size = 0;
+		while (lines_size < lanes) {
+			char *line = lines[lines_size];
+			if (fgets(line, FINGERPRINT_LINE_SIZE, stdin) == NULL) {
+				eof = true;
+				break;
+			}
+			uint16_t line_len = fingerprint_normalize(line);
+			valid[lines_size] = fingerprint_valid(line, line_len);
+			if (valid[lines_size]) {
+				mnemonics[batch_size] = line;
+				mnemonic_lens[batch_size] = line_len;
+				batch_size++;
+			}
+			lines_size++;
+		}
+		uint8_t seeds[PBKDF2_MB_LANES_MAX][64];
+		uint8_t fingerprints[PBKDF2_MB_LANES_MAX][FINGERPRINT_PATHS_MAX][20];
+		if (batch_size != 0) {
+			if (app_code)
+				app_seedutils_bip39_seed(lines[0], mnemonic_lens[0], seeds[0]);
+			else
+				pbkdf2_mb_bip39_seeds(kernel, mnemonics, mnemonic_lens, batch_size, seeds);
+			fingerprint_batch(seeds, batch_size, paths, paths_size, app_code, fingerprints);
+		}
+		for (uint8_t i = 0, mnemonic = 0; i < lines_size; i++) {
+			if (!valid[i]) {
+				printf("invalid\n");
+				all_valid = false;
+				continue;
+			}
+			for (uint8_t j = 0; j < paths_size; j++) {
+				for (uint8_t k = 0; k < 20; k++)
+					printf("%02x", fingerprints[mnemonic][j][k]);
+				printf(j + 1 == paths_size ? "\n" : " ");
+			}
+			mnemonic++;
+		}
+		// Don't leave the mnemonics lying around in the buffers
+		memset(lines, 0, sizeof(lines));
+		memset(seeds, 0, sizeof(seeds));
+	}
+	return all_valid ? 0 : 1;
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Parse a path such as 44'/0'/0' (or 44h/0h/0h) of hardened child indices.
+ *
+ * Returns:
+ *     true if the path is valid, false otherwise
+ */
+static bool fingerprint_parse_path(const char *str, fingerprint_path_t *path_dest) {
+	path_dest->len = 0;
+	while (true) {
+		if (path_dest->len == FINGERPRINT_PATH_LEN_MAX || !isdigit((unsigned char) *str))
+			return false;
+		char *end;
+		unsigned long index = strtoul(str, &end, 10);
+		if (index >= 0x80000000 || (*end != '\'' && *end != 'h'))
+			return false;
+		path_dest->indices[path_dest->len++] = 0x80000000 | index;
+		str = end + 1;
+		if (*str == '\0')
+			return true;
+		if (*str != '/')
+			return false;
+		str++;
+	}
+}
+
+/*
+ * Lower-case the provided null-terminated line and reduce all whitespace in it to single spaces between words, in
+ * place.
+ *
+ * Returns:
+ *     the length of the normalized line
+ */
+static uint16_t fingerprint_normalize(char *line) {
+	uint16_t len = 0;
+	bool space = false;
+	for (const char *c = line; *c != '\0'; c++) {
+		if (isspace((unsigned char) *c)) {
+			space = len != 0;
+			continue;
+		}
+		if (space) {
+			line[len++] = ' ';
+			space = false;
+		}
+		line[len++] = tolower((unsigned char) *c);
+	}
+	line[len] = '\0';
+	return len;
+}
+
+/*
+ * Determine if the provided normalized line is a valid mnemonic: 12, 18, or 24 words of the BIP 39 English wordlist
+ * with a valid checksum.
+ */
+static bool fingerprint_valid(const char *mnemonic, uint16_t mnemonic_len) {
+	// Anything longer than a mnemonic can be is not one; this also keeps the length within a uint8_t
+	if (mnemonic_len > APP_SEEDUTILS_SEED_LENGTH_MAX * (APP_SEEDUTILS_WORD_LEN_MAX + 1) - 1)
+		return false;
+	uint16_t indices[APP_SEEDUTILS_SEED_LENGTH_MAX];
+	uint8_t word_count = app_seedutils_bip39_indices(mnemonic, mnemonic_len, indices);
+	return app_seedutils_valid_checksum_indices(indices, word_count);
+}
+
+/*
+ * Calculate the fingerprints of the nodes at the provided paths derived from each of the provided BIP 39 seeds.
+ *
+ * Args:
+ *     seeds: the seeds; count must not be more than PBKDF2_MB_LANES_MAX
+ *     app_code: whether to calculate the fingerprints with app_seedutils_node_fingerprint() rather than ec_mb.h
+ *     fingerprints_dest: the destination in which to store the fingerprint of each path for each seed
+ */
+static void fingerprint_batch(const uint8_t (*seeds)[64], uint8_t count, const fingerprint_path_t *paths,
+		uint8_t paths_size, bool app_code, uint8_t (*fingerprints_dest)[FINGERPRINT_PATHS_MAX][20]) {
+	// nodes[k][i] is the node of seed k at the first i indices of the previous path (nodes[k][0] is the master node),
+	// and shared is the number of those nodes which are also on the current path, less the master node
+	static uint8_t nodes[PBKDF2_MB_LANES_MAX][FINGERPRINT_PATH_LEN_MAX + 1][64];
+	for (uint8_t k = 0; k < count; k++)
+		app_seedutils_derive_master_node(seeds[k], nodes[k][0]);
+	const fingerprint_path_t *prev = NULL;
+	for (uint8_t i = 0; i < paths_size; i++) {
+		const fingerprint_path_t *path = &paths[i];
+		uint8_t shared = 0;
+		if (prev != NULL) {
+			while (shared < path->len && shared < prev->len && path->indices[shared] == prev->indices[shared])
+				shared++;
+		}
+		uint8_t private_keys[PBKDF2_MB_LANES_MAX][32];
+		for (uint8_t k = 0; k < count; k++) {
+			for (uint8_t j = shared; j < path->len; j++)
+				app_seedutils_derive_path(nodes[k][j], &path->indices[j], 1, nodes[k][j + 1]);
+			memcpy(private_keys[k], nodes[k][path->len], 32);
+		}
+		if (app_code) {
+			for (uint8_t k = 0; k < count; k++)
+				app_seedutils_node_fingerprint(nodes[k][path->len], fingerprints_dest[k][i]);
+		} else {
+			uint8_t public_keys[PBKDF2_MB_LANES_MAX][65];
+			ec_mb_public_keys((const uint8_t (*)[32]) private_keys, count, public_keys);
+			for (uint8_t k = 0; k < count; k++)
+				fingerprint_hash160(public_keys[k], fingerprints_dest[k][i]);
+		}
+		memset(private_keys, 0, sizeof(private_keys));
+		prev = path;
+	}
+	memset(nodes, 0, sizeof(nodes));
+}
+
+/*
+ * Calculate the fingerprint of an uncompressed public key (0x04 || x || y) the way app_seedutils_node_fingerprint()
+ * does: the HASH160 (RIPEMD-160 of SHA-256) of the compressed public key.
+ */
+static void fingerprint_hash160(const uint8_t *public_key, uint8_t *fingerprint_dest) {
+	uint8_t compressed[33];
+	compressed[0] = (public_key[64] & 1) != 0 ? 0x03 : 0x02;
+	memcpy(compressed + 1, public_key + 1, 32);
+	uint8_t hash[32];
+	SHA256(compressed, sizeof(compressed), hash);
+	EVP_Digest(hash, sizeof(hash), fingerprint_dest, NULL, EVP_ripemd160(), NULL);
+}
+
+static void fingerprint_usage() {
+	fprintf(stderr, "Usage: fingerprint [-p path]... [-a]\n");
+}
@@ -0,0 +1,74 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Host stand-in for the parts of the BOLOS SDK cx.h used by app_seedutils.c, so that it can be built into the host
+ * tools. Only the functions app_seedutils.c uses are declared, and they are implemented with OpenSSL, for secp256k1
+ * and one-shot hashing only (anything else aborts).
+ */
+
+#ifndef HOST_CX_H_
+#define HOST_CX_H_
+
+#define CX_CURVE_SECP256K1 0x21
+#define CX_LAST 1
+
+typedef struct {
+	int curve;
+	unsigned int d_len;
+	unsigned char d[32];
+} cx_ecfp_private_key_t;
+
+typedef struct {
+	int curve;
+	unsigned int W_len;
+	unsigned char W[65];
+} cx_ecfp_public_key_t;
+
+typedef struct {
+	int unused;
+} cx_hash_t;
+
+typedef struct {
+	cx_hash_t header;
+} cx_ripemd160_t;
+
+int cx_hash_sha256(const unsigned char *in, unsigned int len, unsigned char *out);
+int cx_hash_sha512(const unsigned char *in, unsigned int len, unsigned char *out);
+
+void cx_pbkdf2_sha512(const unsigned char *password, unsigned int password_len, unsigned char *salt,
+		unsigned int salt_len, unsigned int iterations, unsigned char *out, unsigned int out_len);
+int cx_hmac_sha512(const unsigned char *key, unsigned int key_len, const unsigned char *in, unsigned int len,
+		unsigned char *mac);
+int cx_math_cmp(const unsigned char *a, const unsigned char *b, unsigned int len);
+void cx_math_addm(unsigned char *r, const unsigned char *a, const unsigned char *b, const unsigned char *m,
+		unsigned int len);
+int cx_math_is_zero(const unsigned char *a, unsigned int len);
+int cx_ecfp_init_private_key(int curve, const unsigned char *raw_key, unsigned int key_len,
+		cx_ecfp_private_key_t *private_key);
+int cx_ecfp_generate_pair(int curve, cx_ecfp_public_key_t *public_key, cx_ecfp_private_key_t *private_key,
+		int keep_private);
+int cx_ripemd160_init(cx_ripemd160_t *hash);
+int cx_hash(cx_hash_t *hash, int mode, const unsigned char *in, unsigned int len, unsigned char *out);
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+
+#include "os.h"
+#include "cx.h"
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void host_unavailable(const char *name);
+static void host_failed(const char *name);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+// The secp256k1 group, created on first use and kept (with the generator multiples OpenSSL caches for it) for the life
+// of the process
+static EC_GROUP *host_secp256k1;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+int cx_hash_sha256(const unsigned char *in, unsigned int len, unsigned char *out) {
+	SHA256(in, len, out);
+	return 32;
+}
+
+int cx_hash_sha512(const unsigned char *in, unsigned int len, unsigned char *out) {
+	SHA512(in, len, out);
+	return 64;
+}
+
+void cx_pbkdf2_sha512(const unsigned char *password, unsigned int password_len, unsigned char *salt,
+		unsigned int salt_len, unsigned int iterations, unsigned char *out, unsigned int out_len) {
+	// As app_seedutils_bip39_seed() uses it, salt_len includes 4 trailing bytes reserved for the block index
+	if (PKCS5_PBKDF2_HMAC((const char*) password, password_len, salt, salt_len - 4, iterations, EVP_sha512(), out_len,
+			out) != 1)
+		host_failed("cx_pbkdf2_sha512");
+}
+
+int cx_hmac_sha512(const unsigned char *key, unsigned int key_len, const unsigned char *in, unsigned int len,
+		unsigned char *mac) {
+	// The MAC may be written over the input, so it is computed into a separate buffer first
+	unsigned char result[64];
+	if (HMAC(EVP_sha512(), key, key_len, in, len, result, NULL) == NULL)
+		host_failed("cx_hmac_sha512");
+	memcpy(mac, result, sizeof(result));
+	return 64;
+}
+
+int cx_math_cmp(const unsigned char *a, const unsigned char *b, unsigned int len) {
+	// Both are big-endian integers of the same length
+	return memcmp(a, b, len);
+}
+
+void cx_math_addm(unsigned char *r, const unsigned char *a, const unsigned char *b, const unsigned char *m,
+		unsigned int len) {
+	BN_CTX *ctx = BN_CTX_new();
+	BIGNUM *bn_a = BN_bin2bn(a, len, NULL);
+	BIGNUM *bn_b = BN_bin2bn(b, len, NULL);
+	BIGNUM *bn_m = BN_bin2bn(m, len, NULL);
+	BIGNUM *bn_r = BN_new();
+	if (ctx == NULL || bn_a == NULL || bn_b == NULL || bn_m == NULL || bn_r == NULL ||
+			BN_mod_add(bn_r, bn_a, bn_b, bn_m, ctx) != 1 || BN_bn2binpad(bn_r, r, len) < 0)
+		host_failed("cx_math_addm");
+	BN_clear_free(bn_a);
+	BN_clear_free(bn_b);
+	BN_free(bn_m);
+	BN_clear_free(bn_r);
+	BN_CTX_free(ctx);
+}
+
+int cx_math_is_zero(const unsigned char *a, unsigned int len) {
+	for (unsigned int i = 0; i < len; i++) {
+		if (a[i] != 0)
+			return 0;
+	}
+	return 1;
+}
+
+int cx_ecfp_init_private_key(int curve, const unsigned char *raw_key, unsigned int key_len,
+		cx_ecfp_private_key_t *private_key) {
+	if (curve != CX_CURVE_SECP256K1 || key_len != 32)
+		host_unavailable("cx_ecfp_init_private_key for this curve or key length");
+	private_key->curve = curve;
+	private_key->d_len = key_len;
+	memcpy(private_key->d, raw_key, key_len);
+	return key_len;
+}
+
+int cx_ecfp_generate_pair(int curve, cx_ecfp_public_key_t *public_key, cx_ecfp_private_key_t *private_key,
+		int keep_private) {
+	if (curve != CX_CURVE_SECP256K1 || !keep_private)
+		host_unavailable("cx_ecfp_generate_pair without a provided secp256k1 private key");
+	if (host_secp256k1 == NULL) {
+		host_secp256k1 = EC_GROUP_new_by_curve_name(NID_secp256k1);
+		if (host_secp256k1 == NULL)
+			host_failed("EC_GROUP_new_by_curve_name");
+	}
+	BIGNUM *d = BN_bin2bn(private_key->d, private_key->d_len, NULL);
+	EC_POINT *w = EC_POINT_new(host_secp256k1);
+	if (d == NULL || w == NULL || !EC_POINT_mul(host_secp256k1, w, d, NULL, NULL, NULL))
+		host_failed("EC_POINT_mul");
+	// Like the SDK, store the public key uncompressed: 0x04 || x || y
+	if (EC_POINT_point2oct(host_secp256k1, w, POINT_CONVERSION_UNCOMPRESSED, public_key->W, sizeof(public_key->W),
+			NULL) != sizeof(public_key->W))
+		host_failed("EC_POINT_point2oct");
+	public_key->curve = curve;
+	public_key->W_len = sizeof(public_key->W);
+	BN_clear_free(d);
+	EC_POINT_free(w);
+	return 0;
+}
+
+int cx_ripemd160_init(cx_ripemd160_t *hash) {
+	hash->header.unused = 0;
+	return 0;
+}
+
+int cx_hash(cx_hash_t *hash, int mode, const unsigned char *in, unsigned int len, unsigned char *out) {
+	// The app only ever hashes all of its input at once, so a RIPEMD-160 context carries no state between calls
+	if (mode != CX_LAST)
+		host_unavailable("cx_hash without CX_LAST");
+	if (!EVP_Digest(in, len, out, NULL, EVP_ripemd160(), NULL))
+		host_failed("EVP_Digest (RIPEMD-160)");
+	return 20;
+}
+
+void os_perso_derive_node_bip32(int curve, const uint32_t *path, unsigned int path_len, unsigned char *private_key,
+		unsigned char *chain) {
+	host_unavailable("os_perso_derive_node_bip32");
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void host_unavailable(const char *name) {
+	fprintf(stderr, "%s is not available on the host\n", name);
+	abort();
+}
+
+static void host_failed(const char *name) {
+	fprintf(stderr, "%s failed in OpenSSL\n", name);
+	abort();
+}
@@ -0,0 +1,44 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Host stand-in for the parts of the BOLOS SDK os.h used by app_seedutils.c, so that it can be built into the host
+ * tools. Nothing here is used by the app itself.
+ */
+
+#ifndef HOST_OS_H_
+#define HOST_OS_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define os_memcpy memcpy
+#define os_memmove memmove
+#define os_memset memset
+#define os_memcmp memcmp
+
+// There is no device master seed on the host; this aborts if called
+void os_perso_derive_node_bip32(int curve, const uint32_t *path, unsigned int path_len, unsigned char *private_key,
+		unsigned char *chain);
+
+#endif
@@ -0,0 +1,324 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Keystroke cost simulator for word entry.
+ *
+ * Every word of the wordlist is typed in the way app_rooms_enterword lets the user type it in (using the app's own
+ * app_seedutils_bip39_next_letters() and app_seedutils_order_letters()), on the binary keyboard model of bkb_model.h,
+ * without any mistakes. The number of button presses per word is reported for several entry strategies, along with the
+ * number of presses needed to enter a whole seed from the list of words, assuming every word of the seed is
+ * independently and uniformly chosen from the wordlist. The counts are only as accurate as the model, whose split of
+ * the options is assumed rather than checked against bui_bkb (see bkb_model.h).
+ *
+ * Usage: keysim [-w 0|1] [-k max] [-p 0|1] [-a 0|1] [-b]
+ *     -w: lay out the keyboard by word counts (1) or alphabetically (0) (APP_ENTERWORD_WEIGHTED_LAYOUT)
+ *     -k: the greatest number of words for which a list of words is offered, or 0 for none (APP_ENTERWORD_PICK_MAX)
+ *     -p: offer the word for confirmation once only one word matches the typed letters (1) or not (0)
+ *     -a: move on to the next empty word after each word (1) or return to the list of words (0)
+ *         (APP_ENTERSEED_AUTO_ADVANCE)
+ *     -b: count a backspace option after the letters once a letter has been typed in
+ * If any of -w, -k, or -p is given, only that strategy is simulated; otherwise, the alphabetical, weighted, and pick
+ * list strategies are compared.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "app_seedutils.h"
+
+#include "bkb_model.h"
+
+// The most presses any single word may take to type in
+#define KEYSIM_WORD_PRESSES_MAX 64
+// The most presses any whole seed may take to enter
+#define KEYSIM_SEED_PRESSES_MAX (KEYSIM_WORD_PRESSES_MAX * APP_SEEDUTILS_SEED_LENGTH_MAX)
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                  Internal Type Declarations & Definitions                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+typedef struct {
+	const char *name;
+	// Whether the keyboard is laid out with app_seedutils_order_letters() rather than alphabetically
+	bool weighted;
+	// The greatest number of words matching the typed letters for which a list of those words is offered (0 for none)
+	uint8_t pick_max;
+	// Whether the word is offered for confirmation once it is the only word matching the typed letters
+	bool predict;
+} keysim_strategy_t;
+
+typedef struct {
+	// Whether the list of words moves on to the next empty word after each word is entered
+	bool auto_advance;
+	// Whether the keyboard offers a backspace option after the letters once a letter has been typed in
+	bool backspace;
+} keysim_options_t;
+
+typedef struct {
+	double mean;
+	uint32_t p95;
+	uint32_t max;
+} keysim_stats_t;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static uint8_t keysim_word_presses(const keysim_strategy_t *strategy, const keysim_options_t *options,
+		uint16_t word_index);
+static uint8_t keysim_nav_presses(const keysim_options_t *options, uint8_t seed_length);
+static void keysim_stats(const double *dist, uint32_t dist_size, keysim_stats_t *stats_dest);
+static void keysim_run(const keysim_strategy_t *strategy, const keysim_options_t *options);
+static void keysim_usage();
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static const keysim_strategy_t keysim_builtin_strategies[] = {
+	{ .name = "alphabetical", .weighted = false, .pick_max = 0, .predict = true },
+	{ .name = "weighted", .weighted = true, .pick_max = 0, .predict = true },
+	{ .name = "pick list", .weighted = true, .pick_max = 2, .predict = true },
+};
+
+static const uint8_t keysim_seed_lengths[] = { 12, 18, 24 };
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                               Main Function                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+int main(int argc, char **argv) {
+	keysim_strategy_t custom = keysim_builtin_strategies[2];
+	custom.name = "custom";
+	bool use_custom = false;
+	keysim_options_t options = {
+		.auto_advance = true,
+		.backspace = false,
+	};
+	int opt;
+	while ((opt = getopt(argc, argv, "w:k:p:a:b")) != -1) {
+		switch (opt) {
+		case 'w':
+			custom.weighted = atoi(optarg) != 0;
+			use_custom = true;
+			break;
+		case 'k':
+			custom.pick_max = atoi(optarg);
+			use_custom = true;
+			break;
+		case 'p':
+			custom.predict = atoi(optarg) != 0;
+			use_custom = true;
+			break;
+		case 'a':
+			options.auto_advance = atoi(optarg) != 0;
+			break;
+		case 'b':
+			options.backspace = true;
+			break;
+		default:
+			keysim_usage();
+			return 2;
+		}
+	}
+	if (optind != argc) {
+		keysim_usage();
+		return 2;
+	}
+	printf("Button presses per word (all %u words) and per seed (uniformly random words, %s):\n\n",
+			APP_SEEDUTILS_WORD_COUNT, options.auto_advance ? "with auto-advance" : "without auto-advance");
+	printf("%-14s  %17s", "strategy", "per word");
+	for (uint8_t i = 0; i < sizeof(keysim_seed_lengths); i++)
+		printf("  %11u words", keysim_seed_lengths[i]);
+	printf("\n%-14s  %6s %5s %5s", "", "mean", "p95", "max");
+	for (uint8_t i = 0; i < sizeof(keysim_seed_lengths); i++)
+		printf("  %7s %5s %5s", "mean", "p95", "max");
+	printf("\n");
+	if (use_custom) {
+		keysim_run(&custom, &options);
+	} else {
+		for (uint8_t i = 0; i < sizeof(keysim_builtin_strategies) / sizeof(keysim_builtin_strategies[0]); i++)
+			keysim_run(&keysim_builtin_strategies[i], &options);
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Count the button presses needed to type in a word, from the moment the keyboard is shown to the moment the word is
+ * entered, following app_room_enterword_update_bkb().
+ *
+ * Args:
+ *     strategy: the entry strategy
+ *     options: the simulation options
+ *     word_index: the index of the word to type in; must be in [0, 2047]
+ * Returns:
+ *     the number of presses
+ */
+static uint8_t keysim_word_presses(const keysim_strategy_t *strategy, const keysim_options_t *options,
+		uint16_t word_index) {
+	uint8_t word_len;
+	const char *word = app_seedutils_bip39_word(word_index, &word_len);
+	uint8_t presses = 0;
+	for (uint8_t typed = 0; ; typed++) {
+		char letters[26];
+		uint16_t counts[26];
+		bool complete;
+		int16_t prediction;
+		uint8_t letters_size = app_seedutils_bip39_next_letters(word, typed, letters, counts, &complete, &prediction);
+		// The prediction is confirmed with a single press of the right button
+		if (strategy->predict && prediction != -1)
+			return presses + 1;
+		uint16_t count = complete ? 1 : 0;
+		for (uint8_t i = 0; i < letters_size; i++)
+			count += counts[i];
+		// The list of words is shown with the first word focused; scroll down to the word and press both buttons
+		if (strategy->pick_max > 1 && count > 1 && count <= strategy->pick_max) {
+			uint16_t first;
+			app_seedutils_bip39_prefix_range(word, typed, &first);
+			return presses + (word_index - first) + 1;
+		}
+		// The whole word has been typed in; press both buttons
+		if (typed == word_len)
+			return presses + 1;
+		if (strategy->weighted)
+			app_seedutils_order_letters(letters, counts, letters_size);
+		uint8_t pos = (char*) memchr(letters, word[typed], letters_size) - letters;
+		uint8_t options_size = letters_size + (options->backspace && typed != 0 ? 1 : 0);
+		presses += bkb_model_presses(options_size, pos);
+	}
+}
+
+/*
+ * Count the button presses needed in the list of words of app_rooms_enterseed, from the moment it is shown with the
+ * prompt focused to the moment "Done" is selected, not counting the presses to type in each word.
+ *
+ * Args:
+ *     options: the simulation options
+ *     seed_length: the number of words in the seed
+ * Returns:
+ *     the number of presses
+ */
+static uint8_t keysim_nav_presses(const keysim_options_t *options, uint8_t seed_length) {
+	// Scroll down to the first word and select it; with auto-advance, every other word follows on its own and "Done"
+	// is focused after the last word, and without it, each word is followed by scrolling down to the next one
+	if (options->auto_advance)
+		return 2 + 1;
+	return 2 * seed_length + 2;
+}
+
+/*
+ * Compute statistics of a distribution of button presses.
+ *
+ * Args:
+ *     dist: the probability of each number of presses
+ *     dist_size: the number of elements in dist
+ *     stats_dest: the destination in which to store the statistics
+ */
+static void keysim_stats(const double *dist, uint32_t dist_size, keysim_stats_t *stats_dest) {
+	stats_dest->p95 = 0;
+	stats_dest->max = 0;
+	double mean = 0;
+	double cumulative = 0;
+	bool p95_found = false;
+	for (uint32_t i = 0; i < dist_size; i++) {
+		if (dist[i] == 0)
+			continue;
+		mean += i * dist[i];
+		cumulative += dist[i];
+		// Allow for rounding error in the cumulative probability
+		if (!p95_found && cumulative >= 0.95 - 1e-9) {
+			stats_dest->p95 = i;
+			p95_found = true;
+		}
+		stats_dest->max = i;
+	}
+	stats_dest->mean = mean;
+}
+
+/*
+ * Simulate an entry strategy and print a line of statistics for it.
+ *
+ * Args:
+ *     strategy: the entry strategy
+ *     options: the simulation options
+ */
+static void keysim_run(const keysim_strategy_t *strategy, const keysim_options_t *options) {
+	static double word_dist[KEYSIM_WORD_PRESSES_MAX + 1];
+	static double seed_dist[KEYSIM_SEED_PRESSES_MAX + 1];
+	static double next_dist[KEYSIM_SEED_PRESSES_MAX + 1];
+	memset(word_dist, 0, sizeof(word_dist));
+	for (uint16_t i = 0; i < APP_SEEDUTILS_WORD_COUNT; i++) {
+		uint8_t presses = keysim_word_presses(strategy, options, i);
+		if (presses > KEYSIM_WORD_PRESSES_MAX) {
+			fprintf(stderr, "Word %u takes more than %u presses\n", i, KEYSIM_WORD_PRESSES_MAX);
+			exit(1);
+		}
+		word_dist[presses] += 1.0 / APP_SEEDUTILS_WORD_COUNT;
+	}
+	keysim_stats_t stats;
+	keysim_stats(word_dist, KEYSIM_WORD_PRESSES_MAX + 1, &stats);
+	printf("%-14s  %6.2f %5u %5u", strategy->name, stats.mean, stats.p95, stats.max);
+	// The distribution of the presses for n words is that of n - 1 words convolved with that of a single word
+	memset(seed_dist, 0, sizeof(seed_dist));
+	seed_dist[0] = 1;
+	uint8_t seed_length = 0;
+	for (uint8_t i = 0; i < sizeof(keysim_seed_lengths); i++) {
+		for (; seed_length < keysim_seed_lengths[i]; seed_length++) {
+			memset(next_dist, 0, sizeof(next_dist));
+			for (uint32_t total = 0; total + KEYSIM_WORD_PRESSES_MAX <= KEYSIM_SEED_PRESSES_MAX; total++) {
+				if (seed_dist[total] == 0)
+					continue;
+				for (uint32_t presses = 0; presses <= KEYSIM_WORD_PRESSES_MAX; presses++)
+					next_dist[total + presses] += seed_dist[total] * word_dist[presses];
+			}
+			memcpy(seed_dist, next_dist, sizeof(seed_dist));
+		}
+		keysim_stats(seed_dist, KEYSIM_SEED_PRESSES_MAX + 1, &stats);
+		uint8_t nav = keysim_nav_presses(options, seed_length);
+		printf("  %7.2f %5u %5u", stats.mean + nav, stats.p95 + nav, stats.max + nav);
+	}
+	printf("\n");
+}
+
+static void keysim_usage() {
+	fprintf(stderr, "Usage: keysim [-w 0|1] [-k max] [-p 0|1] [-a 0|1] [-b]\n");
+}
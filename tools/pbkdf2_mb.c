@@ -0,0 +1,272 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <openssl/sha.h>
+
+#include "pbkdf2_mb.h"
+
+#define PBKDF2_MB_NAME_(prefix, suffix) prefix ## suffix
+#define PBKDF2_MB_NAME(prefix, suffix) PBKDF2_MB_NAME_(prefix, suffix)
+
+// The vector kernels need GCC's (or Clang's) vector extensions, function targets and CPU detection on x86-64
+#if defined(__x86_64__) && defined(__GNUC__)
+#define PBKDF2_MB_X86 1
+#else
+#define PBKDF2_MB_X86 0
+#endif
+
+// The number of PBKDF2 iterations of BIP 39
+#define PBKDF2_MB_ITERATIONS 2048
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Variable Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static const uint64_t pbkdf2_mb_sha512_iv[8] = {
+	0x6A09E667F3BCC908, 0xBB67AE8584CAA73B, 0x3C6EF372FE94F82B, 0xA54FF53A5F1D36F1,
+	0x510E527FADE682D1, 0x9B05688C2B3E6C1F, 0x1F83D9ABFB41BD6B, 0x5BE0CD19137E2179,
+};
+
+static const uint64_t pbkdf2_mb_sha512_k[80] = {
+	0x428A2F98D728AE22, 0x7137449123EF65CD, 0xB5C0FBCFEC4D3B2F, 0xE9B5DBA58189DBBC,
+	0x3956C25BF348B538, 0x59F111F1B605D019, 0x923F82A4AF194F9B, 0xAB1C5ED5DA6D8118,
+	0xD807AA98A3030242, 0x12835B0145706FBE, 0x243185BE4EE4B28C, 0x550C7DC3D5FFB4E2,
+	0x72BE5D74F27B896F, 0x80DEB1FE3B1696B1, 0x9BDC06A725C71235, 0xC19BF174CF692694,
+	0xE49B69C19EF14AD2, 0xEFBE4786384F25E3, 0x0FC19DC68B8CD5B5, 0x240CA1CC77AC9C65,
+	0x2DE92C6F592B0275, 0x4A7484AA6EA6E483, 0x5CB0A9DCBD41FBD4, 0x76F988DA831153B5,
+	0x983E5152EE66DFAB, 0xA831C66D2DB43210, 0xB00327C898FB213F, 0xBF597FC7BEEF0EE4,
+	0xC6E00BF33DA88FC2, 0xD5A79147930AA725, 0x06CA6351E003826F, 0x142929670A0E6E70,
+	0x27B70A8546D22FFC, 0x2E1B21385C26C926, 0x4D2C6DFC5AC42AED, 0x53380D139D95B3DF,
+	0x650A73548BAF63DE, 0x766A0ABB3C77B2A8, 0x81C2C92E47EDAEE6, 0x92722C851482353B,
+	0xA2BFE8A14CF10364, 0xA81A664BBC423001, 0xC24B8B70D0F89791, 0xC76C51A30654BE30,
+	0xD192E819D6EF5218, 0xD69906245565A910, 0xF40E35855771202A, 0x106AA07032BBD1B8,
+	0x19A4C116B8D2D0C8, 0x1E376C085141AB53, 0x2748774CDF8EEB99, 0x34B0BCB5E19B48A8,
+	0x391C0CB3C5C95A63, 0x4ED8AA4AE3418ACB, 0x5B9CCA4F7763E373, 0x682E6FF3D6B2B8A3,
+	0x748F82EE5DEFB2FC, 0x78A5636F43172F60, 0x84C87814A1F0AB72, 0x8CC702081A6439EC,
+	0x90BEFFFA23631E28, 0xA4506CEBDE82BDE9, 0xBEF9A3F7B2C67915, 0xC67178F2E372532B,
+	0xCA273ECEEA26619C, 0xD186B8C721C0C207, 0xEADA7DD6CDE0EB1E, 0xF57D4F7FEE6ED178,
+	0x06F067AA72176FBA, 0x0A637DC5A2C898A6, 0x113F9804BEF90DAE, 0x1B710B35131C471B,
+	0x28DB77F523047D84, 0x32CAAB7B40C72493, 0x3C9EBE0A15C9BEBC, 0x431D67C49C100D4C,
+	0x4CC5D4BECB3E42B6, 0x597F299CFC657E2A, 0x5FCB6FAB3AD6FAEC, 0x6C44198C4A475817,
+};
+
+static const char *const pbkdf2_mb_names[PBKDF2_MB_KERNEL_COUNT] = {
+	[PBKDF2_MB_PORTABLE] = "portable",
+	[PBKDF2_MB_AVX2] = "AVX2",
+	[PBKDF2_MB_AVX512] = "AVX-512",
+};
+
+static const uint8_t pbkdf2_mb_kernel_lanes[PBKDF2_MB_KERNEL_COUNT] = {
+	[PBKDF2_MB_PORTABLE] = 1,
+	[PBKDF2_MB_AVX2] = 4,
+	[PBKDF2_MB_AVX512] = 8,
+};
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                             Kernel Definitions                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+#define PBKDF2_MB_KERNEL pbkdf2_mb_portable
+#define PBKDF2_MB_LANES 1
+#define PBKDF2_MB_TARGET
+#include "pbkdf2_mb_kernel.inc"
+#undef PBKDF2_MB_KERNEL
+#undef PBKDF2_MB_LANES
+#undef PBKDF2_MB_TARGET
+
+#if PBKDF2_MB_X86
+#define PBKDF2_MB_KERNEL pbkdf2_mb_avx2
+#define PBKDF2_MB_LANES 4
+#define PBKDF2_MB_TARGET __attribute__((target("avx2")))
+#include "pbkdf2_mb_kernel.inc"
+#undef PBKDF2_MB_KERNEL
+#undef PBKDF2_MB_LANES
+#undef PBKDF2_MB_TARGET
+
+#define PBKDF2_MB_KERNEL pbkdf2_mb_avx512
+#define PBKDF2_MB_LANES 8
+#define PBKDF2_MB_TARGET __attribute__((target("avx512f")))
+#include "pbkdf2_mb_kernel.inc"
+#undef PBKDF2_MB_KERNEL
+#undef PBKDF2_MB_LANES
+#undef PBKDF2_MB_TARGET
+#endif
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static void pbkdf2_mb_compress(uint64_t *state, const uint8_t *block);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       External Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+bool pbkdf2_mb_supported(pbkdf2_mb_kernel_t kernel) {
+	switch (kernel) {
+	case PBKDF2_MB_PORTABLE:
+		return true;
+#if PBKDF2_MB_X86
+	case PBKDF2_MB_AVX2:
+		return __builtin_cpu_supports("avx2");
+	case PBKDF2_MB_AVX512:
+		return __builtin_cpu_supports("avx512f");
+#endif
+	default:
+		return false;
+	}
+}
+
+pbkdf2_mb_kernel_t pbkdf2_mb_best() {
+	pbkdf2_mb_kernel_t best = PBKDF2_MB_PORTABLE;
+	for (pbkdf2_mb_kernel_t kernel = 0; kernel < PBKDF2_MB_KERNEL_COUNT; kernel++) {
+		if (pbkdf2_mb_supported(kernel))
+			best = kernel;
+	}
+	return best;
+}
+
+uint8_t pbkdf2_mb_lanes(pbkdf2_mb_kernel_t kernel) {
+	return pbkdf2_mb_kernel_lanes[kernel];
+}
+
+const char* pbkdf2_mb_name(pbkdf2_mb_kernel_t kernel) {
+	return pbkdf2_mb_names[kernel];
+}
+
+void pbkdf2_mb_bip39_seeds(pbkdf2_mb_kernel_t kernel, const char *const *mnemonics, const uint8_t *mnemonic_lens,
+		uint8_t count, uint8_t (*seeds_dest)[64]) {
+	// The HMAC states and the first iteration are calculated one mnemonic at a time, in the same layout as the kernels
+	// use: word i of lane j is at [i][j]. Unused lanes are left zero and their results ignored.
+	uint64_t ipad[8][PBKDF2_MB_LANES_MAX];
+	uint64_t opad[8][PBKDF2_MB_LANES_MAX];
+	uint64_t u[8][PBKDF2_MB_LANES_MAX];
+	memset(ipad, 0, sizeof(ipad));
+	memset(opad, 0, sizeof(opad));
+	memset(u, 0, sizeof(u));
+	for (uint8_t lane = 0; lane < count; lane++) {
+		// HMAC keys longer than the SHA-512 block size are hashed first, as app_seedutils_bip39_seed() does
+		uint8_t key[128];
+		memset(key, 0, sizeof(key));
+		if (mnemonic_lens[lane] > sizeof(key))
+			SHA512((const unsigned char*) mnemonics[lane], mnemonic_lens[lane], key);
+		else
+			memcpy(key, mnemonics[lane], mnemonic_lens[lane]);
+		uint64_t inner[8];
+		uint64_t outer[8];
+		memcpy(inner, pbkdf2_mb_sha512_iv, sizeof(inner));
+		memcpy(outer, pbkdf2_mb_sha512_iv, sizeof(outer));
+		uint8_t block[128];
+		for (uint8_t i = 0; i < sizeof(block); i++)
+			block[i] = key[i] ^ 0x36;
+		pbkdf2_mb_compress(inner, block);
+		for (uint8_t i = 0; i < sizeof(block); i++)
+			block[i] = key[i] ^ 0x5C;
+		pbkdf2_mb_compress(outer, block);
+		for (uint8_t i = 0; i < 8; i++) {
+			ipad[i][lane] = inner[i];
+			opad[i][lane] = outer[i];
+		}
+		// U1 = HMAC(key, "mnemonic" || block index 1), padded for a 140 byte message (the key block and the salt)
+		memset(block, 0, sizeof(block));
+		memcpy(block, "mnemonic\0\0\0\1\x80", 13);
+		block[126] = (140 * 8) >> 8;
+		block[127] = (140 * 8) & 0xFF;
+		pbkdf2_mb_compress(inner, block);
+		// Then the outer hash, padded for a 192 byte message (the key block and the inner digest)
+		memset(block, 0, sizeof(block));
+		for (uint8_t i = 0; i < 64; i++)
+			block[i] = inner[i / 8] >> (56 - 8 * (i % 8));
+		block[64] = 0x80;
+		block[126] = (192 * 8) >> 8;
+		block[127] = (192 * 8) & 0xFF;
+		pbkdf2_mb_compress(outer, block);
+		for (uint8_t i = 0; i < 8; i++)
+			u[i][lane] = outer[i];
+		memset(key, 0, sizeof(key));
+		memset(block, 0, sizeof(block));
+		memset(inner, 0, sizeof(inner));
+		memset(outer, 0, sizeof(outer));
+	}
+	switch (kernel) {
+#if PBKDF2_MB_X86
+	case PBKDF2_MB_AVX512:
+		pbkdf2_mb_avx512_iterate(ipad, opad, u, PBKDF2_MB_ITERATIONS);
+		break;
+	case PBKDF2_MB_AVX2:
+		pbkdf2_mb_avx2_iterate(ipad, opad, u, PBKDF2_MB_ITERATIONS);
+		if (count > 4)
+			pbkdf2_mb_avx2_iterate((void*) &ipad[0][4], (void*) &opad[0][4], (void*) &u[0][4], PBKDF2_MB_ITERATIONS);
+		break;
+#endif
+	default:
+		for (uint8_t lane = 0; lane < count; lane++)
+			pbkdf2_mb_portable_iterate((void*) &ipad[0][lane], (void*) &opad[0][lane], (void*) &u[0][lane],
+					PBKDF2_MB_ITERATIONS);
+		break;
+	}
+	for (uint8_t lane = 0; lane < count; lane++) {
+		for (uint8_t i = 0; i < 64; i++)
+			seeds_dest[lane][i] = u[i / 8][lane] >> (56 - 8 * (i % 8));
+	}
+	memset(ipad, 0, sizeof(ipad));
+	memset(opad, 0, sizeof(opad));
+	memset(u, 0, sizeof(u));
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+/*
+ * Apply the SHA-512 compression function to a single state, with a message block of 128 bytes.
+ */
+static void pbkdf2_mb_compress(uint64_t *state, const uint8_t *block) {
+	pbkdf2_mb_portable_vec_t vec_state[8];
+	pbkdf2_mb_portable_vec_t vec_block[16];
+	for (uint8_t i = 0; i < 8; i++)
+		memcpy(&vec_state[i], &state[i], sizeof(vec_state[i]));
+	for (uint8_t i = 0; i < 16; i++) {
+		uint64_t word = 0;
+		for (uint8_t j = 0; j < 8; j++)
+			word = (word << 8) | block[i * 8 + j];
+		memcpy(&vec_block[i], &word, sizeof(vec_block[i]));
+	}
+	pbkdf2_mb_portable_compress(vec_state, vec_block);
+	for (uint8_t i = 0; i < 8; i++)
+		memcpy(&state[i], &vec_state[i], sizeof(state[i]));
+}
@@ -0,0 +1,83 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Multi-buffer BIP 39 key stretching for the host tools.
+ *
+ * The 2048 iterations of PBKDF2-HMAC-SHA512 in app_seedutils_bip39_seed() are most of the cost of checking a backup on
+ * the host. They are independent across mnemonics, so this stretches several mnemonics at once, one per 64-bit lane of
+ * a vector register: 8 with AVX-512, 4 with AVX2, or 1 with the portable kernel. The kernel is chosen at run time from
+ * the ones the CPU supports. The seeds are the same as those of app_seedutils_bip39_seed(), as refcheck checks.
+ */
+
+#ifndef PBKDF2_MB_H_
+#define PBKDF2_MB_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The most mnemonics that any kernel stretches at once
+#define PBKDF2_MB_LANES_MAX 8
+
+typedef enum {
+	PBKDF2_MB_PORTABLE,
+	PBKDF2_MB_AVX2,
+	PBKDF2_MB_AVX512,
+	PBKDF2_MB_KERNEL_COUNT,
+} pbkdf2_mb_kernel_t;
+
+/*
+ * Determine if the CPU supports the provided kernel.
+ */
+bool pbkdf2_mb_supported(pbkdf2_mb_kernel_t kernel);
+
+/*
+ * Get the fastest kernel supported by the CPU.
+ */
+pbkdf2_mb_kernel_t pbkdf2_mb_best();
+
+/*
+ * Get the number of mnemonics the provided kernel stretches at once.
+ */
+uint8_t pbkdf2_mb_lanes(pbkdf2_mb_kernel_t kernel);
+
+/*
+ * Get the name of the provided kernel, for reports.
+ */
+const char* pbkdf2_mb_name(pbkdf2_mb_kernel_t kernel);
+
+/*
+ * Generate the BIP 39 seeds of up to PBKDF2_MB_LANES_MAX mnemonics, with an empty passphrase, exactly as
+ * app_seedutils_bip39_seed() does. Stretching fewer mnemonics than the kernel has lanes takes as long as filling them.
+ *
+ * Args:
+ *     kernel: the kernel to use; must be supported by the CPU
+ *     mnemonics: the mnemonics (they are not modified)
+ *     mnemonic_lens: the number of chars in each mnemonic
+ *     count: the number of mnemonics; in [1, PBKDF2_MB_LANES_MAX]
+ *     seeds_dest: the destination in which to store the 64 byte seed of each mnemonic
+ */
+void pbkdf2_mb_bip39_seeds(pbkdf2_mb_kernel_t kernel, const char *const *mnemonics, const uint8_t *mnemonic_lens,
+		uint8_t count, uint8_t (*seeds_dest)[64]);
+
+#endif
@@ -0,0 +1,746 @@
+/*
+ * License for the BOLOS Seed Utility Application project, originally found
+ * here: https://github.com/parkerhoyes/bolos-app-seedutility
+ *
+ * Copyright (C) 2017 Parker Hoyes <contact@parkerhoyes.com>
+ *
+ * This software is provided "as-is", without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ *    that you wrote the original software. If you use this software in a
+ *    product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * Reference checks for app_seedutils.c.
+ *
+ * Each wordlist, packing and checksum function of the app is compared against a straightforward (brute force)
+ * implementation, over every prefix of every word, misspellings of every word, and pseudo-random seeds. The keyboard
+ * layout ordering is checked to take the fewest presses on the binary keyboard model of bkb_model.h; since the model
+ * assumes the same split of the options as the app, this does not check that split against bui_bkb. Key stretching
+ * and BIP 32 derivation are compared against the formulas of BIP 32 and published test vectors, and the node
+ * fingerprint against an independently calculated one. The multi-buffer key stretching of pbkdf2_mb.h is compared
+ * against the app's, and the batched public keys of ec_mb.h against OpenSSL. The exit status is 0 only if there are no
+ * mismatches.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+
+#include "app_seedutils.h"
+
+#include "bkb_model.h"
+#include "ec_mb.h"
+#include "pbkdf2_mb.h"
+
+// The number of pseudo-random seeds checked per seed length
+#define REFCHECK_SEEDS 500
+// The greatest length of the pseudo-random hardened paths along which nodes are derived
+#define REFCHECK_PATH_LEN_MAX 6
+
+// Internal to app_seedutils.c, but not static
+void app_seedutils_set_uint11(uint8_t *arr, uint8_t i, uint16_t n);
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Declarations                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static bool refcheck_next_letters(const char *prefix, uint8_t prefix_len);
+static bool refcheck_prefix_range(const char *prefix, uint8_t prefix_len);
+static bool refcheck_order_letters(const char *prefix, uint8_t prefix_len);
+static bool refcheck_index(const char *word, uint8_t word_len);
+static bool refcheck_neighbors(const char *word, uint8_t word_len);
+static bool refcheck_pack(const uint16_t *indices, uint8_t word_count);
+static bool refcheck_unpack(const uint16_t *indices, uint8_t word_count);
+static bool refcheck_checksum(const uint16_t *indices, uint8_t word_count);
+static bool refcheck_checksum_next(const uint16_t *indices, uint8_t word_count, uint8_t slot);
+static bool refcheck_derive(const uint8_t *seed, const uint32_t *path, uint8_t path_len);
+static bool refcheck_vector(const char *mnemonic, const uint32_t *path, uint8_t path_len, const uint8_t *seed,
+		const char *node_hex);
+
+static bool ref_starts_with(uint16_t wordi, const char *prefix, uint8_t prefix_len);
+static uint8_t ref_distance(const char *a, uint8_t a_len, const char *b, uint8_t b_len);
+static void ref_pack(const uint16_t *indices, uint8_t word_count, uint8_t *ent_dest);
+static bool ref_valid_checksum(const uint16_t *indices, uint8_t word_count);
+static void ref_random_seed(uint16_t *indices_dest, uint8_t word_count);
+static void ref_derive(const uint8_t *seed, const uint32_t *path, uint8_t path_len, uint8_t *node_dest);
+static void ref_hex(const char *hex, uint8_t *dest, uint8_t size);
+static void ref_public_key(const uint8_t *private_key, uint8_t *public_key_dest);
+
+static void refcheck_report(const char *name, uint32_t cases, uint32_t mismatches);
+static uint32_t refcheck_random();
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                Internal Variable Declarations & Definitions                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static uint32_t refcheck_random_state = 0x5EED5EED;
+static uint32_t refcheck_total_mismatches = 0;
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                               Main Function                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+int main() {
+	// Every prefix of every word that is followed by a letter and is shorter than the longest word (the prefixes the
+	// keyboard sees while a word is typed in), and each such prefix followed by a letter that does not continue any word
+	{
+		uint32_t cases = 0;
+		uint32_t mismatches[3] = { 0, 0, 0 };
+		for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+			uint8_t word_len;
+			const char *word = app_seedutils_bip39_word(wordi, &word_len);
+			for (uint8_t prefix_len = 0; prefix_len < word_len && prefix_len < APP_SEEDUTILS_WORD_LEN_MAX;
+					prefix_len++) {
+				// Each prefix is only checked for the first word it is a prefix of
+				if (wordi != 0 && ref_starts_with(wordi - 1, word, prefix_len))
+					continue;
+				char prefix[APP_SEEDUTILS_WORD_LEN_MAX + 1];
+				memcpy(prefix, word, prefix_len);
+				for (char next = 'a' - 1; next <= 'z'; next++) {
+					uint8_t len = prefix_len;
+					if (next >= 'a') {
+						prefix[len++] = next;
+						if (app_seedutils_bip39_prefix_range(prefix, len, NULL) != 0)
+							continue;
+					}
+					cases++;
+					mismatches[0] += refcheck_next_letters(prefix, len) ? 0 : 1;
+					mismatches[1] += refcheck_prefix_range(prefix, len) ? 0 : 1;
+					mismatches[2] += refcheck_order_letters(prefix, len) ? 0 : 1;
+				}
+			}
+		}
+		refcheck_report("app_seedutils_bip39_next_letters", cases, mismatches[0]);
+		refcheck_report("app_seedutils_bip39_prefix_range", cases, mismatches[1]);
+		refcheck_report("app_seedutils_order_letters", cases, mismatches[2]);
+	}
+	// Every word, and one misspelling of each word by each kind of edit (and by two edits)
+	{
+		uint32_t cases = 0;
+		uint32_t mismatches[2] = { 0, 0 };
+		for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+			uint8_t word_len;
+			const char *word = app_seedutils_bip39_word(wordi, &word_len);
+			for (uint8_t edit = 0; edit < 6; edit++) {
+				char typed[APP_SEEDUTILS_WORD_LEN_MAX + 2];
+				uint8_t typed_len = word_len;
+				memcpy(typed, word, word_len);
+				uint8_t pos = refcheck_random() % word_len;
+				switch (edit) {
+				case 0: // Unchanged
+					break;
+				case 1: // A letter deleted
+					memmove(&typed[pos], &typed[pos + 1], word_len - pos - 1);
+					typed_len--;
+					break;
+				case 2: // A letter inserted
+					memmove(&typed[pos + 1], &typed[pos], word_len - pos);
+					typed[pos] = 'a' + refcheck_random() % 26;
+					typed_len++;
+					break;
+				case 3: // A letter replaced
+					typed[pos] = 'a' + refcheck_random() % 26;
+					break;
+				case 4: // Two adjacent letters swapped
+					pos = refcheck_random() % (word_len - 1);
+					typed[pos] = word[pos + 1];
+					typed[pos + 1] = word[pos];
+					break;
+				case 5: // Two letters replaced
+					typed[pos] = 'a' + refcheck_random() % 26;
+					typed[refcheck_random() % word_len] = 'a' + refcheck_random() % 26;
+					break;
+				}
+				if (typed_len > APP_SEEDUTILS_WORD_LEN_MAX)
+					continue;
+				cases++;
+				mismatches[0] += refcheck_index(typed, typed_len) ? 0 : 1;
+				mismatches[1] += refcheck_neighbors(typed, typed_len) ? 0 : 1;
+			}
+		}
+		refcheck_report("app_seedutils_bip39_index", cases, mismatches[0]);
+		refcheck_report("app_seedutils_bip39_neighbors", cases, mismatches[1]);
+	}
+	// Pseudo-random word indices of every length
+	{
+		uint32_t cases = 0;
+		uint32_t mismatches[2] = { 0, 0 };
+		for (uint8_t word_count = 0; word_count <= APP_SEEDUTILS_SEED_LENGTH_MAX; word_count++) {
+			for (uint16_t i = 0; i < REFCHECK_SEEDS; i++) {
+				uint16_t indices[APP_SEEDUTILS_SEED_LENGTH_MAX];
+				for (uint8_t j = 0; j < word_count; j++)
+					indices[j] = refcheck_random() % APP_SEEDUTILS_WORD_COUNT;
+				cases++;
+				mismatches[0] += refcheck_pack(indices, word_count) ? 0 : 1;
+				mismatches[1] += refcheck_unpack(indices, word_count) ? 0 : 1;
+			}
+		}
+		refcheck_report("app_seedutils_bip39_pack", cases, mismatches[0]);
+		refcheck_report("app_seedutils_bip39_unpack", cases, mismatches[1]);
+	}
+	// Pseudo-random seeds with a valid checksum, the same seeds with one word changed, and pseudo-random words
+	{
+		uint32_t cases[2] = { 0, 0 };
+		uint32_t mismatches[2] = { 0, 0 };
+		for (uint8_t word_count = 12; word_count <= APP_SEEDUTILS_SEED_LENGTH_MAX; word_count += 6) {
+			for (uint16_t i = 0; i < REFCHECK_SEEDS; i++) {
+				uint16_t indices[APP_SEEDUTILS_SEED_LENGTH_MAX];
+				ref_random_seed(indices, word_count);
+				cases[0]++;
+				mismatches[0] += refcheck_checksum(indices, word_count) ? 0 : 1;
+				uint8_t slot = refcheck_random() % word_count;
+				// Checking every candidate is slow, so only some seeds are checked
+				if (i % 25 == 0) {
+					cases[1]++;
+					mismatches[1] += refcheck_checksum_next(indices, word_count, slot) ? 0 : 1;
+				}
+				indices[slot] = refcheck_random() % APP_SEEDUTILS_WORD_COUNT;
+				cases[0]++;
+				mismatches[0] += refcheck_checksum(indices, word_count) ? 0 : 1;
+				for (uint8_t j = 0; j < word_count; j++)
+					indices[j] = refcheck_random() % APP_SEEDUTILS_WORD_COUNT;
+				cases[0]++;
+				mismatches[0] += refcheck_checksum(indices, word_count) ? 0 : 1;
+			}
+		}
+		refcheck_report("app_seedutils_valid_checksum", cases[0], mismatches[0]);
+		refcheck_report("app_seedutils_checksum_next", cases[1], mismatches[1]);
+	}
+	// BIP 32 nodes derived along pseudo-random hardened paths from pseudo-random seeds
+	{
+		uint32_t cases = 0;
+		uint32_t mismatches = 0;
+		for (uint16_t i = 0; i < REFCHECK_SEEDS; i++) {
+			uint8_t seed[64];
+			for (uint8_t j = 0; j < sizeof(seed); j++)
+				seed[j] = refcheck_random();
+			uint32_t path[REFCHECK_PATH_LEN_MAX];
+			uint8_t path_len = refcheck_random() % (REFCHECK_PATH_LEN_MAX + 1);
+			for (uint8_t j = 0; j < path_len; j++)
+				path[j] = 0x80000000 | refcheck_random();
+			cases++;
+			mismatches += refcheck_derive(seed, path, path_len) ? 0 : 1;
+		}
+		refcheck_report("app_seedutils_derive_path", cases, mismatches);
+	}
+	// Multi-buffer key stretching with each kernel the CPU supports, against app_seedutils_bip39_seed(), in batches of
+	// every size; the mnemonics are pseudo-random words, and those of 24 words are mostly longer than the SHA-512 block
+	{
+		char mnemonics[PBKDF2_MB_LANES_MAX][APP_SEEDUTILS_SEED_LENGTH_MAX * (APP_SEEDUTILS_WORD_LEN_MAX + 1)];
+		const char *mnemonic_ptrs[PBKDF2_MB_LANES_MAX];
+		uint8_t mnemonic_lens[PBKDF2_MB_LANES_MAX];
+		uint8_t expected[PBKDF2_MB_LANES_MAX][64];
+		for (uint8_t i = 0; i < PBKDF2_MB_LANES_MAX; i++) {
+			uint8_t word_count = 12 + i % 3 * 6;
+			char *dest = mnemonics[i];
+			for (uint8_t j = 0; j < word_count; j++) {
+				uint8_t word_len;
+				const char *word = app_seedutils_bip39_word(refcheck_random() % APP_SEEDUTILS_WORD_COUNT, &word_len);
+				if (j != 0)
+					*dest++ = ' ';
+				memcpy(dest, word, word_len);
+				dest += word_len;
+			}
+			mnemonic_ptrs[i] = mnemonics[i];
+			mnemonic_lens[i] = dest - mnemonics[i];
+			char mnemonic[sizeof(mnemonics[i])];
+			memcpy(mnemonic, mnemonics[i], mnemonic_lens[i]);
+			app_seedutils_bip39_seed(mnemonic, mnemonic_lens[i], expected[i]);
+		}
+		for (pbkdf2_mb_kernel_t kernel = 0; kernel < PBKDF2_MB_KERNEL_COUNT; kernel++) {
+			if (!pbkdf2_mb_supported(kernel))
+				continue;
+			uint32_t cases = 0;
+			uint32_t mismatches = 0;
+			for (uint8_t count = 1; count <= PBKDF2_MB_LANES_MAX; count++) {
+				uint8_t seeds[PBKDF2_MB_LANES_MAX][64];
+				pbkdf2_mb_bip39_seeds(kernel, mnemonic_ptrs, mnemonic_lens, count, seeds);
+				for (uint8_t i = 0; i < count; i++) {
+					cases++;
+					mismatches += memcmp(seeds[i], expected[i], sizeof(seeds[i])) == 0 ? 0 : 1;
+				}
+			}
+			char name[64];
+			snprintf(name, sizeof(name), "pbkdf2_mb_bip39_seeds (%s)", pbkdf2_mb_name(kernel));
+			refcheck_report(name, cases, mismatches);
+		}
+	}
+	// Batched public keys of pseudo-random private keys (and of the smallest and greatest private keys), in batches of
+	// every size
+	{
+		uint32_t cases = 0;
+		uint32_t mismatches = 0;
+		for (uint8_t count = 1; count <= EC_MB_BATCH_MAX; count++) {
+			uint8_t private_keys[EC_MB_BATCH_MAX][32];
+			for (uint8_t i = 0; i < count; i++) {
+				for (uint8_t j = 0; j < 32; j++)
+					private_keys[i][j] = refcheck_random();
+				// Keep the key below the order of the curve
+				private_keys[i][0] &= 0x7F;
+			}
+			if (count == 1) {
+				memset(private_keys[0], 0, 32);
+				private_keys[0][31] = 1;
+			} else if (count == 2) {
+				ref_hex("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140", private_keys[1], 32);
+			}
+			uint8_t public_keys[EC_MB_BATCH_MAX][65];
+			ec_mb_public_keys((const uint8_t (*)[32]) private_keys, count, public_keys);
+			for (uint8_t i = 0; i < count; i++) {
+				uint8_t expected[65];
+				ref_public_key(private_keys[i], expected);
+				cases++;
+				mismatches += memcmp(public_keys[i], expected, sizeof(expected)) == 0 ? 0 : 1;
+			}
+		}
+		refcheck_report("ec_mb_public_keys", cases, mismatches);
+	}
+	// Published test vectors: BIP 39 (the all-"abandon" mnemonic with an empty passphrase) and BIP 32 test vector 3,
+	// whose master private key has a leading zero byte; and the fingerprint of the all-"abandon" mnemonic, calculated
+	// independently
+	{
+		uint8_t seed[64];
+		const uint32_t path_0h = 0x80000000;
+		uint32_t mismatches = 0;
+		mismatches += refcheck_vector("abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+				"abandon abandon about", NULL, 0, NULL,
+				"5eb00bbddcf069084889a8ab9155568165f5c453ccb85e70811aaed6f6da5fc1"
+				"9a5ac40b389cd370d086206dec8aa6c43daea6690f20ad3d8d48b2d2ce9e38e4") ? 0 : 1;
+		ref_hex("4b381541583be4423346c643850da4b320e46a87ae3d2a4e6da11eba819cd4ac"
+				"ba45d239319ac14f863b8d5ab5a0d0c64d2e8a1e7d1457df2e5a3c51c73235be", seed, sizeof(seed));
+		mismatches += refcheck_vector(NULL, &path_0h, 0, seed,
+				"00ddb80b067e0d4993197fe10f2657a844a384589847602d56f0c629c81aae32"
+				"01d28a3e53cffa419ec122c968b3259e16b65076495494d97cae10bbfec3c36f") ? 0 : 1;
+		mismatches += refcheck_vector(NULL, &path_0h, 1, seed,
+				"491f7a2eebc7b57028e0d3faa0acda02e75c33b03c48fb288c41e2ea44e1daef"
+				"e5fea12a97b927fc9dc3d2cb0d1ea1cf50aa5a1fdc1f933e8906bb38df3377bd") ? 0 : 1;
+		char mnemonic[] = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+				"about";
+		const uint32_t compare_path = APP_SEEDUTILS_COMPARE_PATH;
+		uint8_t node[64];
+		uint8_t fingerprint[20];
+		uint8_t expected[20];
+		app_seedutils_bip39_seed(mnemonic, strlen(mnemonic), node);
+		app_seedutils_derive_master_node(node, node);
+		app_seedutils_derive_path(node, &compare_path, 1, node);
+		app_seedutils_node_fingerprint(node, fingerprint);
+		ref_hex("724b931fd072c33faa4b730b6d6f3c709db595e7", expected, sizeof(expected));
+		mismatches += memcmp(fingerprint, expected, sizeof(expected)) == 0 ? 0 : 1;
+		refcheck_report("derivation test vectors", 4, mismatches);
+	}
+	return refcheck_total_mismatches == 0 ? 0 : 1;
+}
+
+//----------------------------------------------------------------------------//
+//                                                                            //
+//                       Internal Function Definitions                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+
+static bool refcheck_next_letters(const char *prefix, uint8_t prefix_len) {
+	uint16_t ref_counts[26];
+	memset(ref_counts, 0, sizeof(ref_counts));
+	bool ref_complete = false;
+	uint16_t matches = 0;
+	int16_t last_match = -1;
+	for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+		if (!ref_starts_with(wordi, prefix, prefix_len))
+			continue;
+		uint8_t word_len;
+		const char *word = app_seedutils_bip39_word(wordi, &word_len);
+		matches++;
+		last_match = wordi;
+		if (word_len == prefix_len)
+			ref_complete = true;
+		else
+			ref_counts[word[prefix_len] - 'a']++;
+	}
+	char letters[26];
+	uint16_t counts[26];
+	bool complete;
+	int16_t prediction;
+	uint8_t letters_size = app_seedutils_bip39_next_letters(prefix, prefix_len, letters, counts, &complete,
+			&prediction);
+	if (complete != ref_complete || prediction != (matches == 1 ? last_match : -1))
+		return false;
+	uint8_t n = 0;
+	for (uint8_t i = 0; i < 26; i++) {
+		if (ref_counts[i] == 0)
+			continue;
+		if (n == letters_size || letters[n] != 'a' + i || counts[n] != ref_counts[i])
+			return false;
+		n++;
+	}
+	if (n != letters_size)
+		return false;
+	// Without counts, the same letters must be found
+	char letters_only[26];
+	if (app_seedutils_bip39_next_letters(prefix, prefix_len, letters_only, NULL, NULL, NULL) != letters_size)
+		return false;
+	return memcmp(letters, letters_only, letters_size) == 0;
+}
+
+static bool refcheck_prefix_range(const char *prefix, uint8_t prefix_len) {
+	uint16_t ref_count = 0;
+	uint16_t ref_first = 0;
+	for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+		if (ref_starts_with(wordi, prefix, prefix_len)) {
+			if (ref_count == 0)
+				ref_first = wordi;
+			ref_count++;
+		}
+	}
+	uint16_t first = APP_SEEDUTILS_WORD_COUNT;
+	uint16_t count = app_seedutils_bip39_prefix_range(prefix, prefix_len, &first);
+	if (count != ref_count)
+		return false;
+	return count == 0 ? first == APP_SEEDUTILS_WORD_COUNT : first == ref_first;
+}
+
+/*
+ * Check that the layout found by app_seedutils_order_letters() takes as few presses as possible (weighted by the number
+ * of words that continue with each letter) on the binary keyboard model. For a fixed number of options the model always
+ * offers the same positions, so the best possible layout pairs the heaviest letters with the positions that take the
+ * fewest presses.
+ */
+static bool refcheck_order_letters(const char *prefix, uint8_t prefix_len) {
+	char letters[26];
+	uint16_t counts[26];
+	uint8_t letters_size = app_seedutils_bip39_next_letters(prefix, prefix_len, letters, counts, NULL, NULL);
+	char ordered[26];
+	memcpy(ordered, letters, letters_size);
+	app_seedutils_order_letters(ordered, counts, letters_size);
+	uint32_t cost = 0;
+	for (uint8_t i = 0; i < letters_size; i++) {
+		const char *pos = memchr(ordered, letters[i], letters_size);
+		if (pos == NULL)
+			return false;
+		cost += (uint32_t) counts[i] * bkb_model_presses(letters_size, pos - ordered);
+	}
+	// Sort the counts (descending) and the presses of every position (ascending), and pair them up
+	uint16_t sorted_counts[26];
+	uint8_t sorted_presses[26];
+	for (uint8_t i = 0; i < letters_size; i++) {
+		uint8_t j = i;
+		for (; j != 0 && sorted_counts[j - 1] < counts[i]; j--)
+			sorted_counts[j] = sorted_counts[j - 1];
+		sorted_counts[j] = counts[i];
+		uint8_t presses = bkb_model_presses(letters_size, i);
+		for (j = i; j != 0 && sorted_presses[j - 1] > presses; j--)
+			sorted_presses[j] = sorted_presses[j - 1];
+		sorted_presses[j] = presses;
+	}
+	uint32_t best = 0;
+	for (uint8_t i = 0; i < letters_size; i++)
+		best += (uint32_t) sorted_counts[i] * sorted_presses[i];
+	return cost == best;
+}
+
+static bool refcheck_index(const char *word, uint8_t word_len) {
+	uint16_t ref_index = APP_SEEDUTILS_WORD_COUNT;
+	for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+		uint8_t len;
+		const char *candidate = app_seedutils_bip39_word(wordi, &len);
+		if (len == word_len && memcmp(candidate, word, len) == 0)
+			ref_index = wordi;
+	}
+	return app_seedutils_bip39_index(word, word_len) == ref_index;
+}
+
+static bool refcheck_neighbors(const char *word, uint8_t word_len) {
+	// Find every word within a single edit, then stably sort them by rank (same first letter first, then same length)
+	uint16_t ref[APP_SEEDUTILS_WORD_COUNT];
+	uint16_t ref_count = 0;
+	for (uint8_t rank = 0; rank < 4; rank++) {
+		for (uint16_t wordi = 0; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+			uint8_t len;
+			const char *candidate = app_seedutils_bip39_word(wordi, &len);
+			uint8_t candidate_rank = (candidate[0] == word[0] ? 0 : 2) + (len == word_len ? 0 : 1);
+			if (candidate_rank == rank && ref_distance(word, word_len, candidate, len) <= 1)
+				ref[ref_count++] = wordi;
+		}
+	}
+	uint16_t neighbors[255];
+	uint8_t count = app_seedutils_bip39_neighbors(word, word_len, neighbors, 255);
+	if (count != ref_count || memcmp(neighbors, ref, count * sizeof(uint16_t)) != 0)
+		return false;
+	// With less room, the best ranked words must be kept
+	count = app_seedutils_bip39_neighbors(word, word_len, neighbors, 4);
+	return count == (ref_count < 4 ? ref_count : 4) && memcmp(neighbors, ref, count * sizeof(uint16_t)) == 0;
+}
+
+static bool refcheck_pack(const uint16_t *indices, uint8_t word_count) {
+	uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+	uint8_t ref_ent[APP_SEEDUTILS_ENT_SIZE];
+	memset(ent, 0xA5, sizeof(ent));
+	app_seedutils_bip39_pack(indices, word_count, ent);
+	ref_pack(indices, word_count, ref_ent);
+	return memcmp(ent, ref_ent, sizeof(ent)) == 0;
+}
+
+static bool refcheck_unpack(const uint16_t *indices, uint8_t word_count) {
+	uint8_t ref_ent[APP_SEEDUTILS_ENT_SIZE];
+	ref_pack(indices, word_count, ref_ent);
+	// Unpacking must give back the packed indices, reading every sequence in place
+	uint16_t unpacked[APP_SEEDUTILS_SEED_LENGTH_MAX];
+	app_seedutils_bip39_unpack(ref_ent, word_count, unpacked);
+	if (memcmp(unpacked, indices, word_count * sizeof(uint16_t)) != 0)
+		return false;
+	// Setting the sequences one at a time, in reverse order, must give the packed bit array
+	uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+	memset(ent, 0, sizeof(ent));
+	for (uint8_t i = word_count; i-- > 0;)
+		app_seedutils_set_uint11(ent, i, indices[i]);
+	return memcmp(ent, ref_ent, sizeof(ent)) == 0;
+}
+
+static bool refcheck_checksum(const uint16_t *indices, uint8_t word_count) {
+	bool ref_valid = ref_valid_checksum(indices, word_count);
+	if (app_seedutils_valid_checksum_indices(indices, word_count) != ref_valid)
+		return false;
+	char mnemonic[APP_SEEDUTILS_SEED_LENGTH_MAX * (APP_SEEDUTILS_WORD_LEN_MAX + 1)];
+	uint16_t mnemonic_len = 0;
+	for (uint8_t i = 0; i < word_count; i++) {
+		uint8_t word_len;
+		const char *word = app_seedutils_bip39_word(indices[i], &word_len);
+		if (i != 0)
+			mnemonic[mnemonic_len++] = ' ';
+		memcpy(&mnemonic[mnemonic_len], word, word_len);
+		mnemonic_len += word_len;
+	}
+	// Mnemonics are at most 24 * 9 - 1 = 215 characters long, so this is never truncated
+	return app_seedutils_valid_checksum(mnemonic, mnemonic_len) == ref_valid;
+}
+
+static bool refcheck_checksum_next(const uint16_t *indices, uint8_t word_count, uint8_t slot) {
+	uint16_t candidates[APP_SEEDUTILS_SEED_LENGTH_MAX];
+	memcpy(candidates, indices, word_count * sizeof(uint16_t));
+	// Iterate over every candidate as app_rooms_recoverword does
+	uint16_t start = 0;
+	while (true) {
+		uint16_t found = app_seedutils_checksum_next(indices, word_count, slot, start);
+		uint16_t ref_found = APP_SEEDUTILS_WORD_COUNT;
+		for (uint16_t wordi = start; wordi < APP_SEEDUTILS_WORD_COUNT; wordi++) {
+			candidates[slot] = wordi;
+			if (ref_valid_checksum(candidates, word_count)) {
+				ref_found = wordi;
+				break;
+			}
+		}
+		if (found != ref_found)
+			return false;
+		if (found == APP_SEEDUTILS_WORD_COUNT)
+			return true;
+		start = found + 1;
+	}
+}
+
+static bool refcheck_derive(const uint8_t *seed, const uint32_t *path, uint8_t path_len) {
+	uint8_t ref_node[64];
+	ref_derive(seed, path, path_len, ref_node);
+	uint8_t master_node[64];
+	app_seedutils_derive_master_node(seed, master_node);
+	uint8_t node[64];
+	app_seedutils_derive_path(master_node, path, path_len, node);
+	if (memcmp(node, ref_node, sizeof(node)) != 0)
+		return false;
+	// Continuing in place from a node on the path must give the same node
+	uint8_t shared = path_len == 0 ? 0 : refcheck_random() % (path_len + 1);
+	app_seedutils_derive_path(master_node, path, shared, node);
+	app_seedutils_derive_path(node, path + shared, path_len - shared, node);
+	return memcmp(node, ref_node, sizeof(node)) == 0;
+}
+
+/*
+ * Check a published test vector. The node is derived from the seed of the mnemonic if it is not NULL, or from the
+ * provided seed otherwise; if path is NULL, the expected value is the seed itself instead of a node.
+ */
+static bool refcheck_vector(const char *mnemonic, const uint32_t *path, uint8_t path_len, const uint8_t *seed,
+		const char *node_hex) {
+	uint8_t expected[64];
+	ref_hex(node_hex, expected, sizeof(expected));
+	uint8_t actual[64];
+	if (mnemonic != NULL) {
+		char buff[256];
+		uint8_t mnemonic_len = strlen(mnemonic);
+		memcpy(buff, mnemonic, mnemonic_len);
+		app_seedutils_bip39_seed(buff, mnemonic_len, actual);
+	} else {
+		memcpy(actual, seed, sizeof(actual));
+	}
+	if (path != NULL) {
+		app_seedutils_derive_master_node(actual, actual);
+		app_seedutils_derive_path(actual, path, path_len, actual);
+	}
+	return memcmp(actual, expected, sizeof(expected)) == 0;
+}
+
+static bool ref_starts_with(uint16_t wordi, const char *prefix, uint8_t prefix_len) {
+	uint8_t word_len;
+	const char *word = app_seedutils_bip39_word(wordi, &word_len);
+	return word_len >= prefix_len && memcmp(word, prefix, prefix_len) == 0;
+}
+
+/*
+ * Compute the optimal string alignment distance between two strings (the number of letters inserted, deleted, or
+ * replaced, or adjacent letters swapped, to turn one into the other, where no letter is edited twice).
+ */
+static uint8_t ref_distance(const char *a, uint8_t a_len, const char *b, uint8_t b_len) {
+	uint8_t d[APP_SEEDUTILS_WORD_LEN_MAX + 2][APP_SEEDUTILS_WORD_LEN_MAX + 2];
+	for (uint8_t i = 0; i <= a_len; i++) {
+		for (uint8_t j = 0; j <= b_len; j++) {
+			if (i == 0 || j == 0) {
+				d[i][j] = i + j;
+				continue;
+			}
+			uint8_t best = d[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+			if (d[i - 1][j] + 1 < best)
+				best = d[i - 1][j] + 1;
+			if (d[i][j - 1] + 1 < best)
+				best = d[i][j - 1] + 1;
+			if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1] && d[i - 2][j - 2] + 1 < best)
+				best = d[i - 2][j - 2] + 1;
+			d[i][j] = best;
+		}
+	}
+	return d[a_len][b_len];
+}
+
+static void ref_pack(const uint16_t *indices, uint8_t word_count, uint8_t *ent_dest) {
+	memset(ent_dest, 0, APP_SEEDUTILS_ENT_SIZE);
+	for (uint16_t bit = 0; bit < word_count * 11; bit++) {
+		if ((indices[bit / 11] >> (10 - bit % 11)) & 1)
+			ent_dest[bit / 8] |= 0x80 >> (bit % 8);
+	}
+}
+
+static bool ref_valid_checksum(const uint16_t *indices, uint8_t word_count) {
+	if (word_count != 12 && word_count != 18 && word_count != 24)
+		return false;
+	uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+	ref_pack(indices, word_count, ent);
+	uint16_t ent_bits = word_count * 32 / 3;
+	uint8_t hash[32];
+	SHA256(ent, ent_bits / 8, hash);
+	for (uint8_t bit = 0; bit < word_count / 3; bit++) {
+		bool expected = (hash[bit / 8] >> (7 - bit % 8)) & 1;
+		bool actual = (ent[(ent_bits + bit) / 8] >> (7 - (ent_bits + bit) % 8)) & 1;
+		if (expected != actual)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * Generate a pseudo-random seed with a valid checksum.
+ */
+static void ref_random_seed(uint16_t *indices_dest, uint8_t word_count) {
+	uint8_t ent[APP_SEEDUTILS_ENT_SIZE];
+	memset(ent, 0, sizeof(ent));
+	uint8_t ent_size = word_count * 4 / 3;
+	for (uint8_t i = 0; i < ent_size; i++)
+		ent[i] = refcheck_random();
+	uint8_t hash[32];
+	SHA256(ent, ent_size, hash);
+	ent[ent_size] = hash[0] & (0xFF << (8 - word_count / 3));
+	for (uint8_t i = 0; i < word_count; i++) {
+		uint16_t index = 0;
+		for (uint16_t bit = i * 11; bit < i * 11 + 11; bit++)
+			index = (index << 1) | ((ent[bit / 8] >> (7 - bit % 8)) & 1);
+		indices_dest[i] = index;
+	}
+}
+
+/*
+ * Derive the BIP 32 node along a hardened path from a 64 byte seed, straight from the formulas in BIP 32: the master
+ * node is HMAC-SHA512("Bitcoin seed", seed), and the child i of (k, c) is (IL + k mod n, IR), where IL || IR is
+ * HMAC-SHA512(c, 0x00 || k || i). A result that is not a valid key is vanishingly unlikely, so it is not handled.
+ */
+static void ref_derive(const uint8_t *seed, const uint32_t *path, uint8_t path_len, uint8_t *node_dest) {
+	HMAC(EVP_sha512(), "Bitcoin seed", 12, seed, 64, node_dest, NULL);
+	BN_CTX *ctx = BN_CTX_new();
+	BIGNUM *n = NULL;
+	BN_hex2bn(&n, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+	for (uint8_t i = 0; i < path_len; i++) {
+		uint8_t data[37];
+		data[0] = 0;
+		memcpy(data + 1, node_dest, 32);
+		for (uint8_t j = 0; j < 4; j++)
+			data[33 + j] = path[i] >> (24 - 8 * j);
+		uint8_t mac[64];
+		HMAC(EVP_sha512(), node_dest + 32, 32, data, sizeof(data), mac, NULL);
+		BIGNUM *k = BN_bin2bn(node_dest, 32, NULL);
+		BIGNUM *il = BN_bin2bn(mac, 32, NULL);
+		BN_mod_add(k, k, il, n, ctx);
+		BN_bn2binpad(k, node_dest, 32);
+		memcpy(node_dest + 32, mac + 32, 32);
+		BN_free(k);
+		BN_free(il);
+	}
+	BN_free(n);
+	BN_CTX_free(ctx);
+}
+
+/*
+ * Calculate an uncompressed secp256k1 public key (0x04 || x || y) with OpenSSL.
+ */
+static void ref_public_key(const uint8_t *private_key, uint8_t *public_key_dest) {
+	EC_GROUP *group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+	BIGNUM *d = BN_bin2bn(private_key, 32, NULL);
+	EC_POINT *w = EC_POINT_new(group);
+	EC_POINT_mul(group, w, d, NULL, NULL, NULL);
+	EC_POINT_point2oct(group, w, POINT_CONVERSION_UNCOMPRESSED, public_key_dest, 65, NULL);
+	EC_POINT_free(w);
+	BN_free(d);
+	EC_GROUP_free(group);
+}
+
+static void ref_hex(const char *hex, uint8_t *dest, uint8_t size) {
+	for (uint8_t i = 0; i < size; i++) {
+		unsigned int byte;
+		sscanf(hex + 2 * i, "%2x", &byte);
+		dest[i] = byte;
+	}
+}
+
+static void refcheck_report(const char *name, uint32_t cases, uint32_t mismatches) {
+	printf("%-36s %7u cases, %u mismatches\n", name, cases, mismatches);
+	refcheck_total_mismatches += mismatches;
+}
+
+/*
+ * Get the next number from a fixed xorshift sequence, so that every run checks the same cases.
+ */
+static uint32_t refcheck_random() {
+	refcheck_random_state ^= refcheck_random_state << 13;
+	refcheck_random_state ^= refcheck_random_state >> 17;
+	refcheck_random_state ^= refcheck_random_state << 5;
+	return refcheck_random_state;
+}